@@ -0,0 +1,183 @@
+#ifndef ANYTIME_H
+#define ANYTIME_H
+
+#include "../data structures/graph.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+/**
+ * Anytime solving: every algorithm has an overload taking SolveOptions that stops
+ * at a deadline, on cancellation or once the result is close enough to optimal.
+ * The result then holds the best flow value found so far and the capacity of
+ * an s-t cut (separating all sources from all sinks), so the maximum flow is
+ * always in [flow, upper_bound].
+ */
+namespace algorithms {
+
+    /**
+     * @brief Set from any thread to stop a running solve.
+     */
+    class CancellationToken {
+        public:
+            void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+            bool cancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+        private:
+            std::atomic<bool> m_cancelled{false};
+    };
+
+    /**
+     * @brief Passed to the progress callback.
+     */
+    template <typename T>
+    struct Progress {
+        // value of the flow (or preflow into t) found so far
+        T flow{0};
+        std::chrono::steady_clock::duration elapsed{};
+    };
+
+    template <typename T>
+    struct SolveOptions {
+        /**
+         * @brief Stop at this point in time. The algorithms check it every few vertices
+         *        they visit, the result follows after one more bfs for the upper bound.
+         */
+        std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+
+        /**
+         * @brief Stop once cancelled (optional).
+         */
+        const CancellationToken* cancellation{nullptr};
+
+        /**
+         * @brief Called every interval with the flow found so far (optional).
+         */
+        std::function<void(const Progress<T>&)> progress{};
+
+        /**
+         * @brief Stop once upper_bound - flow <= tolerance. Checked every interval,
+         *        each check costs a bfs over the residual network. 0 = run to optimality.
+         */
+        T tolerance{0};
+
+        /**
+         * @brief How often progress and tolerance are checked.
+         */
+        std::chrono::steady_clock::duration interval{std::chrono::milliseconds{10}};
+    };
+
+    /**
+     * @brief Why a solve returned.
+     */
+    enum class SolveStatus {
+        optimal,
+        within_tolerance,
+        deadline,
+        cancelled
+    };
+
+    template <typename T>
+    struct SolveResult {
+        /**
+         * @brief Value of the flow found. For the push-relabel algorithms it is the 
+         *        flow into t of a preflow, which can be turned into a flow with the same value.
+         */
+        T flow{0};
+
+        /**
+         * @brief Capacity of an s-t cut in the residual network, the maximum flow is at most this.
+         */
+        T upper_bound{0};
+
+        SolveStatus status{SolveStatus::optimal};
+
+        T gap() const { return upper_bound - flow; }
+    };
+
+    /**
+     * @brief Checked by the algorithms between units of work (augmentations, phases, discharges).
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     */
+    template <typename T, typename I>
+    class Stopper {
+        public:
+            /**
+             * @param calls_per_check Read the clock only every that many calls. 1 for units
+             *                        of work that can take long (an augmenting path search
+             *                        is a bfs over the whole network), more for tiny ones.
+             */
+            Stopper(const ds::Graph<T, I>& graph, const SolveOptions<T>& options, unsigned int calls_per_check = 1);
+
+            /**
+             * @brief Whether the algorithm has to stop now.
+             * 
+             * @param flow The flow found so far, or a function returning it if it is
+             *             expensive to compute (only called when needed).
+             */
+            bool stop(const auto& flow);
+
+            /**
+             * @brief Whether the algorithm has to stop now, for the inner loops of a unit of
+             *        work (a search over the whole network takes far longer than the deadline
+             *        allows on large networks). Reads the clock every 1024 calls, stays true
+             *        once true.
+             */
+            bool interrupted();
+
+            SolveStatus status() const { return m_status; }
+
+        private:
+            const ds::Graph<T, I>& m_graph;
+            const SolveOptions<T>& m_options;
+            std::chrono::steady_clock::time_point m_start{};
+            std::chrono::steady_clock::time_point m_next_check{};
+            unsigned int m_calls_per_check{1};
+            unsigned int m_calls{0};
+            unsigned int m_steps{0};
+            SolveStatus m_status{SolveStatus::optimal};
+
+            /**
+             * @brief Sets the status if cancelled or past the deadline.
+             */
+            bool expired(std::chrono::steady_clock::time_point now);
+    };
+
+    /**
+     * @brief Used by the plain algorithms, never stops.
+     */
+    struct NoStop {
+        static constexpr bool stop(auto) { return false; }
+        static constexpr bool interrupted() { return false; }
+    };
+
+    /**
+     * @brief Upper bound on the maximum flow, from the current residual network.
+     * 
+     *        Levels of a bfs from all sources over edges with positive residual capacity define
+     *        the cuts S_k = {v : level(v) < k} for 1 <= k <= level of the closest sink. Returns 
+     *        the smallest capacity (in the original network) of these cuts, or of the reachable 
+     *        set if no sink is reachable (the flow is maximum and the bound equals it).
+     *        Cuts are summed in a wider type, the largest T is returned if all of them exceed it.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return T The capacity of a cut between all sources and all sinks.
+     */
+    template <typename T, typename I>
+    T residual_cut_bound(const ds::Graph<T, I>& graph);
+
+    /**
+     * @brief Builds the result of a solve that returned the given flow.
+     */
+    template <typename T, typename I>
+    SolveResult<T> make_result(const ds::Graph<T, I>& graph, T flow, SolveStatus status);
+}
+
+#include "anytime.ipp"
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef ANYTIME_IPP
+#define ANYTIME_IPP
+
+#include "../data structures/graph.h"
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+
+namespace algorithms {
+
+    template <typename T, typename I>
+    Stopper<T, I>::Stopper(const ds::Graph<T, I>& graph, const SolveOptions<T>& options, unsigned int calls_per_check)
+        : m_graph{graph}
+        , m_options{options}
+        , m_start{std::chrono::steady_clock::now()}
+        , m_next_check{m_start + options.interval}
+        , m_calls_per_check{std::max(calls_per_check, 1u)} {}
+
+    /**
+     * @brief Whether the algorithm has to stop now.
+     * 
+     * @param flow The flow found so far, or a function returning it.
+     */
+    template <typename T, typename I>
+    bool Stopper<T, I>::stop(const auto& flow) {
+        if(m_status != SolveStatus::optimal) { return true; }
+        if(++m_calls < m_calls_per_check) { return false; }
+        m_calls = 0;
+        auto now{std::chrono::steady_clock::now()};
+        if(expired(now)) { return true; }
+        if(now < m_next_check) { return false; }
+        m_next_check = now + m_options.interval;
+        T value{};
+        if constexpr(std::is_invocable_v<decltype(flow)>) {
+            value = flow();
+        } else {
+            value = flow;
+        }
+        if(m_options.progress) {
+            m_options.progress(Progress<T>{value, now - m_start});
+        }
+        if(m_options.tolerance > 0 && std::max(value, residual_cut_bound(m_graph)) - value <= m_options.tolerance) {
+            m_status = SolveStatus::within_tolerance;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Whether the algorithm has to stop now, for the inner loops of a unit of work.
+     */
+    template <typename T, typename I>
+    bool Stopper<T, I>::interrupted() {
+        if(m_status != SolveStatus::optimal) { return true; }
+        if((++m_steps & 1023) != 0) { return false; }
+        return expired(std::chrono::steady_clock::now());
+    }
+
+    template <typename T, typename I>
+    bool Stopper<T, I>::expired(std::chrono::steady_clock::time_point now) {
+        if(m_options.cancellation && m_options.cancellation->cancelled()) {
+            m_status = SolveStatus::cancelled;
+            return true;
+        }
+        if(now >= m_options.deadline) {
+            m_status = SolveStatus::deadline;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Upper bound on the maximum flow, from the current residual network.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return T The capacity of a cut between all sources and all sinks.
+     */
+    template <typename T, typename I>
+    T residual_cut_bound(const ds::Graph<T, I>& graph) {
+        std::vector<I> level(graph.m_n, -1);
+        std::vector<I> to_visit{};
+        for(I source : graph.sources()) {
+            level[source] = 0;
+            to_visit.push_back(source);
+        }
+        for(std::size_t i{0}; i < to_visit.size(); ++i) {
+            I vertex{to_visit[i]};
+            for(auto* edge : graph.m_adj_list[vertex]) {
+                if(edge->capacity <= 0 || level[edge->head] != -1) { continue; }
+                level[edge->head] = level[vertex]+1;
+                to_visit.push_back(edge->head);
+            }
+        }
+        auto level_of = [&](I v) { return level[v] == -1 ? std::numeric_limits<I>::max() : level[v]; };
+        // every S_k with k up to the closest sink contains no sink
+        I closest{std::numeric_limits<I>::max()};
+        for(I sink : graph.sinks()) {
+            closest = std::min(closest, level_of(sink));
+        }
+        // no sink reachable: the reachable set is a cut, only k = 1 with "level" 1 = unreachable
+        I last{closest == std::numeric_limits<I>::max() ? I{1} : closest};
+        if(closest == std::numeric_limits<I>::max()) {
+            for(I v : to_visit) { level[v] = 0; }
+        }
+        // edge (u, v) crosses S_k for level(u) < k <= level(v), added as a range to cut[k]
+        // (summed in a wider type, a cut can have more capacity than T holds)
+        using Sum = ds::CapacitySum<T>;
+        std::vector<Sum> cut(last+2, 0);
+        for(I u : to_visit) {
+            for(auto* edge : graph.m_adj_list[u]) {
+                I from{level[u]+1};
+                I to{std::min(level_of(edge->head), last)};
+                if(from > to) { continue; }
+                cut[from] += edge->back_up_capacity;
+                cut[to+1] -= edge->back_up_capacity;
+            }
+        }
+        Sum bound{std::numeric_limits<T>::max()};
+        Sum capacity{0};
+        for(I k{1}; k <= last; ++k) {
+            capacity += cut[k];
+            bound = std::min(bound, capacity);
+        }
+        // a cut above the largest T still bounds any flow that fits in T
+        return static_cast<T>(bound);
+    }
+
+    /**
+     * @brief Builds the result of a solve that returned the given flow.
+     */
+    template <typename T, typename I>
+    SolveResult<T> make_result(const ds::Graph<T, I>& graph, T flow, SolveStatus status) {
+        if(status == SolveStatus::optimal) {
+            return {flow, flow, status};
+        }
+        // no cut has less capacity than a flow, clamped so the gap is never negative
+        return {flow, std::max(flow, residual_cut_bound(graph)), status};
+    }
+}
+
+#endif
@@ -18,6 +18,9 @@ namespace counters {
     unsigned long long dinic_edges_visited{0};
     // considering the number of paths until a blocking flow is found
     unsigned long long dinic_augmenting_paths{0};
+    // edges checked to advance in the forest, the bfs is shared with dinic's and counted there
+    unsigned long long dinic_dt_edges_visited{0};
+    unsigned long long dinic_dt_augmenting_paths{0};
     unsigned long long hi_pr_pushes{0};
     unsigned long long hi_pr_relabels{0};
     unsigned long long pr_pushes{0};
@@ -2,6 +2,8 @@
 #define DINIC_H
 
 #include "../data structures/graph.h"
+#include "workspace.h"
+#include "anytime.h"
 
 namespace algorithms {
 
@@ -10,11 +12,36 @@ namespace algorithms {
      *        Dinic's algorithm.
      * 
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
      * @return T The value of a maximum flow.
      */
-    template <typename T>
-    T dinic(ds::Graph<T>& graph);
+    template <typename T, typename I>
+    T dinic(ds::Graph<T, I>& graph);
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T dinic(ds::Graph<T, I>& graph, DinicWorkspace<T, I>& workspace);
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> dinic(ds::Graph<T, I>& graph, DinicWorkspace<T, I>& workspace, const SolveOptions<T>& options);
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> dinic(ds::Graph<T, I>& graph, const SolveOptions<T>& options);
     
 }
 
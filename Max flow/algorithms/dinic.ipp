@@ -2,41 +2,79 @@
 #define DINIC_IPP
 
 #include "../data structures/graph.h"
+#include "workspace.h"
+#include "anytime.h"
 #include "counter.h"
+#include "kernels.h"
 #include <iostream>
 #include <vector>
-#include <queue>
+#include <limits>
+#include <algorithm>
 
 namespace algorithms {
 
     /**
      * @brief Assigns each vertex in the graph a level, where the level is the
-     *        number of edges on the shortest path from s to the vertex.
+     *        number of edges on the shortest path from a source to the vertex.
      * 
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network. 
-     * @return A vector (container) where each vertex indexes its level in the graph.
+     * @param workspace Stores the level of each reached vertex, see DinicWorkspace::level.
+     * @param stopper Checked for every vertex visited (Stopper or NoStop), no sink is reached once it says stop.
+     * @return Whether a sink was reached.
      */
-    template <typename T>
-    std::vector<int> build_level_graph(const ds::Graph<T>& graph) {
-        std::vector<int> level(graph.m_n, -1);
-        level[graph.m_s] = 0;
-        std::queue<int> to_visit{};
-        to_visit.push(graph.m_s);
-        while(!to_visit.empty()) {
-            int vertex{to_visit.front()};
-            to_visit.pop();
-            for(auto* edge : graph.m_adj_list[vertex]) {
+    template <typename T, typename I>
+    bool build_level_graph(const ds::Graph<T, I>& graph, DinicWorkspace<T, I>& workspace, auto& stopper) {
+        auto& level{workspace.m_level};
+        auto& reached{workspace.m_reached};
+        auto& to_visit{workspace.m_queue};
+        // unreach every vertex of the last level graph (new epoch)
+        reached.clear();
+        std::size_t front{0};
+        std::size_t back{0};
+        // all sources on level 0
+        for(I source : graph.sources()) {
+            reached.visit(source);
+            level[source] = 0;
+            workspace.m_edges_to_visit[source] = 0;
+            to_visit[back++] = source;
+        }
+        auto reach{[&](I vertex, I head) {
+            reached.visit(head);
+            level[head] = level[vertex]+1;
+            // the dfs considers all edges of a vertex again
+            workspace.m_edges_to_visit[head] = 0;
+            to_visit[back++] = head;
+        }};
+        while(front < back) {
+            if(stopper.interrupted()) { return false; }
+            I vertex{to_visit[front++]};
+            auto edges{graph.m_adj_list[vertex]};
+            if(edges.size() >= kernels::simd_min_degree) {
+                // counter for comparison, irrelevant to dinic's
+                counters::dinic_edges_visited += edges.size();
+                auto& candidates{workspace.m_candidates};
+                if(candidates.size() < edges.size()) { candidates.resize(edges.size()); }
+                std::size_t found{kernels::collect_unreached(edges.data(), edges.size(), 
+                    reached.stamps(), reached.epoch(), candidates.data())};
+                for(std::size_t i{0}; i < found; ++i) {
+                    // parallel edges to the same head are all candidates
+                    I head{edges[candidates[i]]->head};
+                    if(!reached.visited(head)) { reach(vertex, head); }
+                }
+                continue;
+            }
+            for(auto* edge : edges) {
                 // counter for comparison, irrelevant to dinic's
                 ++counters::dinic_edges_visited;
-                if(edge->capacity <= 0 || level[edge->head] != -1) {
+                if(edge->capacity <= 0 || reached.visited(edge->head)) {
                     continue;
                 }
-                level[edge->head] = level[vertex]+1;
-                to_visit.push(edge->head);
+                reach(vertex, edge->head);
             }
         }
-        return level;
+        return std::ranges::any_of(graph.sinks(), [&reached](I sink) { return reached.visited(sink); });
     }
 
     /**
@@ -45,27 +83,30 @@ namespace algorithms {
      * 
      *
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
      * @param vertex The current vertex visited by the search.
      * @param flow_pushed The flow pushed to this vertex so far.
-     * @param level The current level of each vertex in the residual network.
-     * @param edges_to_visit The edges that the current dfs needs to consider.
+     * @param workspace The current level of each vertex in the residual network and 
+     *                  the edges that the current dfs needs to consider.
+     * @param stopper Checked for every vertex visited (Stopper or NoStop), nothing is pushed once it says stop.
      * @return The flow pushed on the augmenting path found.
      */
-    template <typename T>
-    T dinic_dfs(auto& graph, int vertex, T flow_pushed, std::vector<int>& level, std::vector<int>& edges_to_visit) {
-        if(graph.m_t == vertex) { 
+    template <typename T, typename I>
+    T dinic_dfs(auto& graph, I vertex, T flow_pushed, DinicWorkspace<T, I>& workspace, auto& stopper) {
+        if(graph.is_sink(vertex)) { 
             return flow_pushed; 
         }
-        for(int& i{edges_to_visit[vertex]}; i < graph.m_adj_list[vertex].size(); ++i) {
+        if(stopper.interrupted()) { return 0; }
+        for(I& i{workspace.m_edges_to_visit[vertex]}; i < static_cast<I>(graph.m_adj_list[vertex].size()); ++i) {
             // counter for comparison, irrelevant to dinic's
             ++counters::dinic_edges_visited;
             auto* edge{graph.m_adj_list[vertex][i]};
-            if(level[edge->head] - 1 != level[vertex] || edge->capacity <= 0) {
+            if(workspace.level(edge->head) - 1 != workspace.m_level[vertex] || edge->capacity <= 0) {
                 continue;
             }
-            T push{dinic_dfs(graph, edge->head, std::min(flow_pushed, edge->capacity), level, edges_to_visit)};
-            // no s-t path using this edge
+            T push{dinic_dfs<T, I>(graph, edge->head, std::min(flow_pushed, edge->capacity), workspace, stopper)};
+            // no path to a sink using this edge
             if(push == 0) {
                 continue;
             }
@@ -74,36 +115,83 @@ namespace algorithms {
             edge->reverse->capacity += push;
             return push;
         }
-        // no s-t path using this vertex
+        // no path to a sink using this vertex
         return 0;
     }
 
     /**
-     * @brief Computes the maximum flow of the given graph using 
-     *        Dinic's algorithm.
+     * @brief Main loop of dinic's algorithm.
      * 
-     * @tparam T Flow type.
-     * @param graph The residual network.
-     * @return T The value of a maximum flow.
+     * @param stopper Checked after every augmenting path and every phase (Stopper or NoStop).
+     * @return The value of a maximum flow (of the flow found if stopped).
      */
-    template <typename T>
-    T dinic(ds::Graph<T>& graph) {
+    template <typename T, typename I>
+    T _dinic(ds::Graph<T, I>& graph, DinicWorkspace<T, I>& workspace, auto& stopper) {
+        workspace.prepare(graph);
         T max_flow{0};
         T flow_pushed{0};
-        std::vector<int> level = build_level_graph(graph);
-        // stores the next edge that can be considered during the next dfs on the current level graph
-        std::vector<int> edges_to_visit(graph.m_n, 0);
-        while(level[graph.m_t] != -1) {
-            // push until a blocking flow is found
-            while((flow_pushed = dinic_dfs<T>(graph, graph.m_s, std::numeric_limits<T>::max(), level, edges_to_visit))) {
-                max_flow += flow_pushed;
+        while(build_level_graph(graph, workspace, stopper)) {
+            // push from every source until a blocking flow is found
+            for(I source : graph.sources()) {
+                while((flow_pushed = dinic_dfs<T, I>(graph, source, std::numeric_limits<T>::max(), workspace, stopper))) {
+                    max_flow += flow_pushed;
+                    if(stopper.stop(max_flow)) { return max_flow; }
+                }
             }
-            // next level graph, considering all edges in the dfs again
-            level = build_level_graph(graph);
-            std::fill(edges_to_visit.begin(), edges_to_visit.end(), 0);
+            // a phase can end without augmenting paths, its bfs still counts as work
+            if(stopper.stop(max_flow)) { return max_flow; }
         }
         return max_flow;
     }
+
+    /**
+     * @brief Computes the maximum flow of the given graph using 
+     *        Dinic's algorithm.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return T The value of a maximum flow.
+     */
+    template <typename T, typename I>
+    T dinic(ds::Graph<T, I>& graph) {
+        DinicWorkspace<T, I> workspace{};
+        return dinic(graph, workspace);
+    }
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T dinic(ds::Graph<T, I>& graph, DinicWorkspace<T, I>& workspace) {
+        NoStop no_stop{};
+        return _dinic(graph, workspace, no_stop);
+    }
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> dinic(ds::Graph<T, I>& graph, DinicWorkspace<T, I>& workspace, const SolveOptions<T>& options) {
+        Stopper<T, I> stopper{graph, options};
+        T flow{_dinic(graph, workspace, stopper)};
+        return make_result(graph, flow, stopper.status());
+    }
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> dinic(ds::Graph<T, I>& graph, const SolveOptions<T>& options) {
+        DinicWorkspace<T, I> workspace{};
+        return dinic(graph, workspace, options);
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
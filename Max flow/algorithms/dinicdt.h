@@ -0,0 +1,55 @@
+#ifndef DINIC_DT_H
+#define DINIC_DT_H
+
+#include "../data structures/graph.h"
+#include "workspace.h"
+#include "anytime.h"
+
+namespace algorithms {
+
+    /**
+     * @brief Computes the maximum flow of the given graph using 
+     *        Dinic's algorithm, finding each blocking flow with 
+     *        Sleator's and Tarjan's dynamic trees (O(nm log n) in total).
+     * 
+     *        An augmentation costs O(log n) amortized instead of the length of the path,
+     *        which pays off on deep level graphs.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return T The value of a maximum flow.
+     */
+    template <typename T, typename I>
+    T dinic_dynamic_trees(ds::Graph<T, I>& graph);
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T dinic_dynamic_trees(ds::Graph<T, I>& graph, DynamicTreeDinicWorkspace<T, I>& workspace);
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> dinic_dynamic_trees(ds::Graph<T, I>& graph, DynamicTreeDinicWorkspace<T, I>& workspace, 
+            const SolveOptions<T>& options);
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> dinic_dynamic_trees(ds::Graph<T, I>& graph, const SolveOptions<T>& options);
+    
+}
+
+#include "dinicdt.ipp"
+
+#endif
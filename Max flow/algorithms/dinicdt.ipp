@@ -0,0 +1,181 @@
+#ifndef DINIC_DT_IPP
+#define DINIC_DT_IPP
+
+#include "../data structures/graph.h"
+#include "dinic.h"
+#include "workspace.h"
+#include "anytime.h"
+#include "counter.h"
+
+#include <vector>
+
+namespace algorithms {
+
+    /**
+     * @brief Removes the current edge of a vertex from the forest and writes the
+     *        flow pushed over it while it was in the forest to the edge.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param workspace The forest and its edges.
+     * @param vertex A vertex that is not a root.
+     */
+    template <typename T, typename I>
+    void cut_tree_edge(DynamicTreeDinicWorkspace<T, I>& workspace, I vertex) {
+        auto*& edge{workspace.m_tree_edge[vertex]};
+        T residual{workspace.m_tree.cut(vertex)};
+        edge->reverse->capacity += edge->capacity - residual;
+        edge->capacity = residual;
+        edge = nullptr;
+    }
+
+    /**
+     * @brief Main loop of dinic's algorithm with dynamic trees.
+     *
+     *        Per phase, the forest consists of current edges of the level graph. The root
+     *        of the tree containing a source either gets linked along its next admissible
+     *        edge (advance), is a sink and the path to it gets augmented as a whole
+     *        (saturated edges are cut), or has no admissible edge left and is removed
+     *        with all edges into it (retreat).
+     *
+     * @param stopper Checked after every augmenting path and every phase (Stopper or NoStop).
+     * @return The value of a maximum flow (of the flow found if stopped).
+     */
+    template <typename T, typename I>
+    T _dinic_dynamic_trees(ds::Graph<T, I>& graph, DynamicTreeDinicWorkspace<T, I>& workspace, auto& stopper) {
+        workspace.prepare(graph);
+        auto& levels{workspace.m_levels};
+        auto& tree{workspace.m_tree};
+        auto& tree_edge{workspace.m_tree_edge};
+        auto& dead{workspace.m_dead};
+        // current edge of each vertex, the one linked while it is not a root
+        auto& current_edges{levels.m_edges_to_visit};
+        T max_flow{0};
+        bool stopped{false};
+        while(!stopped && build_level_graph(graph, levels, stopper)) {
+            dead.clear();
+            for(I source : graph.sources()) {
+                // no vertex links to a source, it starts as a root
+                I root{source};
+                while(!stopped) {
+                    if(stopper.interrupted()) {
+                        stopped = true;
+                        break;
+                    }
+                    if(graph.is_sink(root)) {
+                        // augment along the whole path at once
+                        T flow_pushed{tree.path_min(source)};
+                        tree.path_add(source, -flow_pushed);
+                        max_flow += flow_pushed;
+                        ++counters::dinic_dt_augmenting_paths;
+                        // saturated edges leave the forest, the lowest one becomes the root
+                        while(tree.path_min(source) == 0) {
+                            root = tree.path_min_vertex(source);
+                            cut_tree_edge(workspace, root);
+                            ++current_edges[root];
+                        }
+                        stopped = stopper.stop(max_flow);
+                        continue;
+                    }
+                    // advance
+                    auto edges{graph.m_adj_list[root]};
+                    I& i{current_edges[root]};
+                    for(; i < static_cast<I>(edges.size()); ++i) {
+                        // counter for comparison, irrelevant to the algorithm
+                        ++counters::dinic_dt_edges_visited;
+                        auto* edge{edges[i]};
+                        if(edge->capacity > 0 && levels.level(edge->head) == levels.m_level[root]+1
+                                && !dead.visited(edge->head)) {
+                            break;
+                        }
+                    }
+                    if(i < static_cast<I>(edges.size())) {
+                        I head{edges[i]->head};
+                        tree.link(root, head, edges[i]->capacity);
+                        tree_edge[root] = edges[i];
+                        workspace.m_linked.push_back(root);
+                        // only search if the head is part of another tree
+                        root = tree_edge[head] ? tree.find_root(head) : head;
+                        continue;
+                    }
+                    // retreat: no path to a sink from here in this level graph
+                    dead.visit(root);
+                    if(root == source) { break; }
+                    I children{0};
+                    I child{-1};
+                    for(auto* edge : edges) {
+                        // the reverse edge is the current edge of its tail
+                        if(tree_edge[edge->head] == edge->reverse) {
+                            child = edge->head;
+                            ++children;
+                            cut_tree_edge(workspace, child);
+                            ++current_edges[child];
+                        }
+                    }
+                    // the source is below one of the children, with only one it is the new root
+                    root = children == 1 ? child : tree.find_root(source);
+                }
+            }
+            // write the flow of the edges still in the forest to the graph
+            for(I vertex : workspace.m_linked) {
+                if(tree_edge[vertex]) { cut_tree_edge(workspace, vertex); }
+            }
+            workspace.m_linked.clear();
+            // a phase can end without augmenting paths, its bfs still counts as work
+            stopped = stopped || stopper.stop(max_flow);
+        }
+        return max_flow;
+    }
+
+    /**
+     * @brief Computes the maximum flow of the given graph using
+     *        Dinic's algorithm with dynamic trees.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return T The value of a maximum flow.
+     */
+    template <typename T, typename I>
+    T dinic_dynamic_trees(ds::Graph<T, I>& graph) {
+        DynamicTreeDinicWorkspace<T, I> workspace{};
+        return dinic_dynamic_trees(graph, workspace);
+    }
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     *
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T dinic_dynamic_trees(ds::Graph<T, I>& graph, DynamicTreeDinicWorkspace<T, I>& workspace) {
+        NoStop no_stop{};
+        return _dinic_dynamic_trees(graph, workspace, no_stop);
+    }
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     *
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> dinic_dynamic_trees(ds::Graph<T, I>& graph, DynamicTreeDinicWorkspace<T, I>& workspace,
+            const SolveOptions<T>& options) {
+        Stopper<T, I> stopper{graph, options};
+        T flow{_dinic_dynamic_trees(graph, workspace, stopper)};
+        return make_result(graph, flow, stopper.status());
+    }
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> dinic_dynamic_trees(ds::Graph<T, I>& graph, const SolveOptions<T>& options) {
+        DynamicTreeDinicWorkspace<T, I> workspace{};
+        return dinic_dynamic_trees(graph, workspace, options);
+    }
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define EDMONDS_KARP_H
 
 #include "../data structures/graph.h"
+#include "workspace.h"
+#include "anytime.h"
 #include "counter.h"
 
 
@@ -12,11 +14,76 @@ namespace algorithms {
      *        to find augmenting paths.
      * 
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
      * @return T The value of a maximum flow.
      */
-    template <typename T>
-    T edmonds_karp(ds::Graph<T>& graph);
+    template <typename T, typename I>
+    T edmonds_karp(ds::Graph<T, I>& graph);
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T edmonds_karp(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace);
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> edmonds_karp(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace, const SolveOptions<T>& options);
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> edmonds_karp(ds::Graph<T, I>& graph, const SolveOptions<T>& options);
+
+    /**
+     * @brief Computes the maximum flow of the given graph using
+     *        the ford-fulkerson method and a bidirectional breath-first
+     *        search to find (shortest) augmenting paths. Same paths lengths
+     *        as edmonds-karp, the search meets in the middle instead of
+     *        scanning everything closer to the sources than the nearest sink.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return T The value of a maximum flow.
+     */
+    template <typename T, typename I>
+    T edmonds_karp_bidirectional(ds::Graph<T, I>& graph);
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     *
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T edmonds_karp_bidirectional(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace);
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     *
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> edmonds_karp_bidirectional(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace,
+            const SolveOptions<T>& options);
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> edmonds_karp_bidirectional(ds::Graph<T, I>& graph, const SolveOptions<T>& options);
 }
 
 #include "edmondskarp.ipp"
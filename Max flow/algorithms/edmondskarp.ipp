@@ -3,8 +3,9 @@
 
 #include "fordfulkerson.ipp"
 #include "../data structures/graph.h"
-#include <queue>
-#include <map>
+#include "workspace.h"
+#include "anytime.h"
+#include <limits>
 
 namespace algorithms {
 
@@ -13,53 +14,259 @@ namespace algorithms {
      * 
      *
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network. 
-     * @param augmenting_path Container to save the path from s to t if one is found.
+     * @param workspace Saves the path from a source to a sink if one is found (augmenting path of visited vertices).
+     * @param stopper Checked for every vertex visited (Stopper or NoStop), no path is returned once it says stop.
      * @return The maximum flow that can be pushed on the path found.
      */
-    template <typename T>
-    T ff_bfs(const ds::Graph<T>& graph, auto& augmenting_path) {
-        // queue containing (vertex, flow pushed so far) pairs
-        std::queue<std::pair<int, T>> to_visit{};
-        // "infinite" flow to start the bfs
-        to_visit.emplace(graph.m_s, std::numeric_limits<T>::max());
-
-        while(!to_visit.empty()) {
-            auto current_vertex{to_visit.front()}; // (vertex, flow) pair
-            to_visit.pop();
+    template <typename T, typename I, typename Stop>
+    T ff_bfs(const ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace, Stop& stopper) {
+        auto& augmenting_path{workspace.m_augmenting_path};
+        auto& visited{workspace.m_visited};
+        // queue containing (vertex, flow pushed so far) pairs, front is the next to visit
+        auto& to_visit{workspace.m_to_visit};
+        std::size_t front{0};
+        to_visit.clear();
+        // "infinite" flow from every source to start the bfs
+        for(I source : graph.sources()) {
+            to_visit.emplace_back(source, std::numeric_limits<T>::max());
+            visited.visit(source);
+        }
+
+        while(front < to_visit.size()) {
+            if(stopper.interrupted()) { return 0; }
+            auto current_vertex{to_visit[front++]}; // (vertex, flow) pair
             for(auto* edge : graph.m_adj_list[current_vertex.first]) {
                 // counter for comparison, irrelevant to the search
                 ++counters::ek_edges_visited;
-                if(augmenting_path[edge->head] || edge->capacity <= 0) {
+                if(visited.visited(edge->head) || edge->capacity <= 0) {
                     continue;
                 }
                 T new_flow_pushed{std::min(current_vertex.second, edge->capacity)};
                 // remember current edge
                 augmenting_path[edge->head] = edge;
-                if(edge->head == graph.m_t) {
+                visited.visit(edge->head);
+                if(graph.is_sink(edge->head)) {
+                    workspace.m_sink = edge->head;
                     return new_flow_pushed;
                 }
-                to_visit.emplace(edge->head, new_flow_pushed);
+                to_visit.emplace_back(edge->head, new_flow_pushed);
             }
         }
-        // no s-t path
+        // no path from a source to a sink
         return 0;
     }
 
+    /**
+     * @brief Bidirectional bfs used by ford-fulkerson.
+     *
+     *        Grows one frontier from the sources over edges with residual capacity and one
+     *        from the sinks over edges with residual capacity into them, always expanding the
+     *        smaller frontier by a whole level. Stops at the first edge joining both halves,
+     *        which closes a shortest augmenting path, like ff_bfs but usually after far fewer edges.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @param workspace Saves the path from a source to a sink if one is found (augmenting path of visited vertices).
+     * @param stopper Checked for every vertex visited (Stopper or NoStop), no path is returned once it says stop.
+     * @return The maximum flow that can be pushed on the path found.
+     */
+    template <typename T, typename I, typename Stop>
+    T ff_bibfs(const ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace, Stop& stopper) {
+        auto& augmenting_path{workspace.m_augmenting_path};
+        auto& next_edge{workspace.m_next_edge};
+        auto& visited{workspace.m_visited};
+        auto& visited_backward{workspace.m_visited_backward};
+        // queue containing (vertex, flow pushed so far) pairs, as in ff_bfs
+        auto& to_visit{workspace.m_to_visit};
+        auto& backward{workspace.m_backward};
+        // the current level of each half is [front, size)
+        std::size_t front{0};
+        std::size_t backward_front{0};
+        to_visit.clear();
+        backward.clear();
+        visited_backward.clear();
+        for(I source : graph.sources()) {
+            to_visit.emplace_back(source, std::numeric_limits<T>::max());
+            visited.visit(source);
+        }
+        for(I sink : graph.sinks()) {
+            backward.push_back(sink);
+            visited_backward.visit(sink);
+        }
+
+        // edge from a vertex reached from a source to one reached from a sink
+        typename ds::Graph<T, I>::Edge* meeting{nullptr};
+        T flow_pushed{0};
+        while(!meeting && front < to_visit.size() && backward_front < backward.size()) {
+            if(to_visit.size() - front <= backward.size() - backward_front) {
+                for(std::size_t end{to_visit.size()}; !meeting && front < end; ++front) {
+                    if(stopper.interrupted()) { return 0; }
+                    auto current_vertex{to_visit[front]}; // (vertex, flow) pair
+                    for(auto* edge : graph.m_adj_list[current_vertex.first]) {
+                        // counter for comparison, irrelevant to the search
+                        ++counters::ek_edges_visited;
+                        if(visited.visited(edge->head) || edge->capacity <= 0) {
+                            continue;
+                        }
+                        T new_flow_pushed{std::min(current_vertex.second, edge->capacity)};
+                        if(visited_backward.visited(edge->head)) {
+                            meeting = edge;
+                            flow_pushed = new_flow_pushed;
+                            break;
+                        }
+                        augmenting_path[edge->head] = edge;
+                        visited.visit(edge->head);
+                        to_visit.emplace_back(edge->head, new_flow_pushed);
+                    }
+                }
+            } else {
+                for(std::size_t end{backward.size()}; !meeting && backward_front < end; ++backward_front) {
+                    if(stopper.interrupted()) { return 0; }
+                    I vertex{backward[backward_front]};
+                    for(auto* edge : graph.m_adj_list[vertex]) {
+                        ++counters::ek_edges_visited;
+                        // the reverse edge leads from the head to the vertex
+                        auto* into{edge->reverse};
+                        if(visited_backward.visited(edge->head) || into->capacity <= 0) {
+                            continue;
+                        }
+                        if(visited.visited(edge->head)) {
+                            meeting = into;
+                            break;
+                        }
+                        next_edge[edge->head] = into;
+                        visited_backward.visit(edge->head);
+                        backward.push_back(edge->head);
+                    }
+                }
+            }
+        }
+        // no path from a source to a sink
+        if(!meeting) { return 0; }
+
+        if(flow_pushed == 0) {
+            // met while searching from the sinks, the flow to the tail is not known
+            flow_pushed = meeting->capacity;
+            for(I vertex{meeting->tail}; !graph.is_source(vertex); vertex = augmenting_path[vertex]->tail) {
+                flow_pushed = std::min(flow_pushed, augmenting_path[vertex]->capacity);
+            }
+        }
+        // continue the path toward a sink so that ford-fulkerson can walk it back
+        I vertex{meeting->head};
+        augmenting_path[vertex] = meeting;
+        while(!graph.is_sink(vertex)) {
+            auto* edge{next_edge[vertex]};
+            flow_pushed = std::min(flow_pushed, edge->capacity);
+            augmenting_path[edge->head] = edge;
+            vertex = edge->head;
+        }
+        workspace.m_sink = vertex;
+        return flow_pushed;
+    }
+
     /**
      * @brief Computes the maximum flow of the given graph using 
      *        the ford-fulkerson method and a breath-first search 
      *        to find augmenting paths.
      * 
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
      * @return T The value of a maximum flow.
      */
-    template <typename T>
-    T edmonds_karp(ds::Graph<T>& graph) {
-        return _ford_fulkerson(graph, &ff_bfs);
+    template <typename T, typename I>
+    T edmonds_karp(ds::Graph<T, I>& graph) {
+        FordFulkersonWorkspace<T, I> workspace{};
+        return edmonds_karp(graph, workspace);
     }
 
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T edmonds_karp(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace) {
+        NoStop no_stop{};
+        return _ford_fulkerson<T, I>(graph, &ff_bfs<T, I, NoStop>, workspace, no_stop);
+    }
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> edmonds_karp(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace, const SolveOptions<T>& options) {
+        Stopper<T, I> stopper{graph, options};
+        T flow{_ford_fulkerson<T, I>(graph, &ff_bfs<T, I, Stopper<T, I>>, workspace, stopper)};
+        return make_result(graph, flow, stopper.status());
+    }
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> edmonds_karp(ds::Graph<T, I>& graph, const SolveOptions<T>& options) {
+        FordFulkersonWorkspace<T, I> workspace{};
+        return edmonds_karp(graph, workspace, options);
+    }
+
+    /**
+     * @brief Computes the maximum flow of the given graph using
+     *        the ford-fulkerson method and a bidirectional breath-first
+     *        search to find (shortest) augmenting paths.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return T The value of a maximum flow.
+     */
+    template <typename T, typename I>
+    T edmonds_karp_bidirectional(ds::Graph<T, I>& graph) {
+        FordFulkersonWorkspace<T, I> workspace{};
+        return edmonds_karp_bidirectional(graph, workspace);
+    }
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     *
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T edmonds_karp_bidirectional(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace) {
+        NoStop no_stop{};
+        return _ford_fulkerson<T, I>(graph, &ff_bibfs<T, I, NoStop>, workspace, no_stop);
+    }
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     *
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> edmonds_karp_bidirectional(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace,
+            const SolveOptions<T>& options) {
+        Stopper<T, I> stopper{graph, options};
+        T flow{_ford_fulkerson<T, I>(graph, &ff_bibfs<T, I, Stopper<T, I>>, workspace, stopper)};
+        return make_result(graph, flow, stopper.status());
+    }
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> edmonds_karp_bidirectional(ds::Graph<T, I>& graph, const SolveOptions<T>& options) {
+        FordFulkersonWorkspace<T, I> workspace{};
+        return edmonds_karp_bidirectional(graph, workspace, options);
+    }
 }
 
 #endif
@@ -2,9 +2,10 @@
 #define FORD_FULKERSON_IPP
 
 #include "../data structures/graph.h"
+#include "workspace.h"
+#include "anytime.h"
 #include "counter.h"
-#include <stack>
-#include <map>
+#include <limits>
 
 namespace algorithms {
 
@@ -13,36 +14,47 @@ namespace algorithms {
      * 
      *
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network. 
-     * @param augmenting_path Container to save the path from s to t if one is found.
+     * @param workspace Saves the path from a source to a sink if one is found (augmenting path of visited vertices).
+     * @param stopper Checked for every vertex visited (Stopper or NoStop), no path is returned once it says stop.
      * @return The maximum flow that can be pushed on the path found.
      */
-    template <typename T>
-    T ff_dfs(const ds::Graph<T>& graph, auto& augmenting_path) {
+    template <typename T, typename I, typename Stop>
+    T ff_dfs(const ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace, Stop& stopper) {
+        auto& augmenting_path{workspace.m_augmenting_path};
+        auto& visited{workspace.m_visited};
         // stack containing (vertex, flow pushed so far) pairs
-        std::stack<std::pair<int, T>> to_visit{};
-        // "infinite" flow from s to start the dfs
-        to_visit.emplace(graph.m_s, std::numeric_limits<T>::max());
+        auto& to_visit{workspace.m_to_visit};
+        to_visit.clear();
+        // "infinite" flow from every source to start the dfs
+        for(I source : graph.sources()) {
+            to_visit.emplace_back(source, std::numeric_limits<T>::max());
+            visited.visit(source);
+        }
 
         while(!to_visit.empty()) {
-            auto current_vertex{to_visit.top()}; // (vertex, flow) pair
-            to_visit.pop();
+            if(stopper.interrupted()) { return 0; }
+            auto current_vertex{to_visit.back()}; // (vertex, flow) pair
+            to_visit.pop_back();
             for(auto* edge : graph.m_adj_list[current_vertex.first]) {
                 // counter for comparison, irrelevant to the search
                 ++counters::ff_edges_visited;
-                if(augmenting_path[edge->head] || edge->capacity <= 0) {
+                if(visited.visited(edge->head) || edge->capacity <= 0) {
                     continue;
                 }
                 T new_flow_pushed{std::min(current_vertex.second, edge->capacity)};
                 // remember the current edge
                 augmenting_path[edge->head] = edge;
-                if(edge->head == graph.m_t) {
+                visited.visit(edge->head);
+                if(graph.is_sink(edge->head)) {
+                    workspace.m_sink = edge->head;
                     return new_flow_pushed;
                 }
-                to_visit.emplace(edge->head, new_flow_pushed);
+                to_visit.emplace_back(edge->head, new_flow_pushed);
             }
         }
-        // no s-t path
+        // no path from a source to a sink
         return 0;
     }
 
@@ -52,32 +64,36 @@ namespace algorithms {
      * 
      *
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
      * @param search The search function to be used to find augmenting paths.
-     * @return The value of a maximum flow.
+     * @param workspace Buffers of the search, reused for every augmenting path.
+     * @param stopper Checked after every augmentation (Stopper or NoStop).
+     * @return The value of a maximum flow (of the flow found if stopped).
      */
-    template <typename T>
-    T _ford_fulkerson(ds::Graph<T>& graph, 
-            T (* search) (const ds::Graph<T>& graph, 
-                std::vector<typename ds::Graph<T>::Edge*>& augmenting_path)) {
-        // to store the augmenting path
-        std::vector<typename ds::Graph<T>::Edge*> augmenting_path(graph.m_n, nullptr);
+    template <typename T, typename I, typename Stop>
+    T _ford_fulkerson(ds::Graph<T, I>& graph, 
+            T (* search) (const ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace, Stop& stopper),
+            FordFulkersonWorkspace<T, I>& workspace, Stop& stopper) {
+        workspace.prepare(graph);
+        auto& augmenting_path{workspace.m_augmenting_path};
         T max_flow{0};
         // flow pushed by the next augmenting path
         T flow_pushed{0};
         // find augmenting path using the given search function
-        while((flow_pushed = search(graph, augmenting_path))) {
-            int v{graph.m_t};
+        while((flow_pushed = search(graph, workspace, stopper))) {
+            I v{workspace.m_sink};
             // update capacities
-            while(v != graph.m_s) {
+            while(!graph.is_source(v)) {
                 auto* edge = augmenting_path[v];
                 edge->capacity -= flow_pushed;
                 edge->reverse->capacity += flow_pushed;
                 v = edge->tail;
             }
             max_flow += flow_pushed;
-            // clear current augmenting path for the next one
-            std::fill(augmenting_path.begin(), augmenting_path.end(), nullptr);
+            // clear current augmenting path for the next one (new epoch, no O(n) clear)
+            workspace.m_visited.clear();
+            if(stopper.stop(max_flow)) { break; }
         }
         return max_flow;
     }
@@ -88,13 +104,49 @@ namespace algorithms {
      *        to find augmenting paths.
      * 
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
      * @return T The value of a maximum flow.
      */
-    template <typename T> 
-    T ford_fulkerson(ds::Graph<T>& graph) {
-        return _ford_fulkerson<T>(graph, &ff_dfs);
+    template <typename T, typename I> 
+    T ford_fulkerson(ds::Graph<T, I>& graph) {
+        FordFulkersonWorkspace<T, I> workspace{};
+        return ford_fulkerson(graph, workspace);
+    }
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I> 
+    T ford_fulkerson(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace) {
+        NoStop no_stop{};
+        return _ford_fulkerson<T, I>(graph, &ff_dfs<T, I, NoStop>, workspace, no_stop);
+    }
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> ford_fulkerson(ds::Graph<T, I>& graph, FordFulkersonWorkspace<T, I>& workspace, const SolveOptions<T>& options) {
+        Stopper<T, I> stopper{graph, options};
+        T flow{_ford_fulkerson<T, I>(graph, &ff_dfs<T, I, Stopper<T, I>>, workspace, stopper)};
+        return make_result(graph, flow, stopper.status());
+    }
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> ford_fulkerson(ds::Graph<T, I>& graph, const SolveOptions<T>& options) {
+        FordFulkersonWorkspace<T, I> workspace{};
+        return ford_fulkerson(graph, workspace, options);
     }
 }
 
-#endif
\ No newline at end of file
+#endif
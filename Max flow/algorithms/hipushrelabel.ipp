@@ -3,10 +3,11 @@
 
 #include "../data structures/graph.h"
 #include "pushrelabel.h"
+#include "workspace.h"
+#include "anytime.h"
 #include "counter.h"
 
 #include <vector>
-#include <queue>
 
 namespace algorithms {
 
@@ -16,87 +17,87 @@ namespace algorithms {
      *        for the highest label selection rule.
      * 
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
-     * @param excess The excess at each vertex (inf for s, 0 every other vertex).
+     * @param excess The excess at each vertex (all 0).
      * @param active The buckets.
      * @param labels The labels for each vertex.
      * @return int The highest label when initializing the buckets.
      */
-    template <typename T>
-    void initialize_buckets(ds::Graph<T>& graph, std::vector<T>& excess, 
-            std::vector<std::queue<int>>& active, const std::vector<int>& labels) {
-        for(auto* edge : graph.m_adj_list[graph.m_s]) {
-            if(push(excess, edge)) {
-                if(edge->head != graph.m_t) {
-                    active[labels[edge->head]].push(edge->head);
+    template <typename T, typename I>
+    void initialize_buckets(ds::Graph<T, I>& graph, std::vector<T>& excess, 
+            Buckets<I>& active, const std::vector<I>& labels) {
+        for(I source : graph.sources()) {
+            for(auto* edge : graph.m_adj_list[source]) {
+                if(!graph.is_source(edge->head) && saturate(excess, edge)) {
+                    if(!graph.is_sink(edge->head)) {
+                        active.push(labels[edge->head], edge->head);
+                    }
                 }
             }
         }
     }
 
     /**
-     * @brief Computes the maximum flow in a given flow network using 
-     *        Goldberg's and Tarjan's push-relabel algorithm and the
-     *        highest label selection rule.
+     * @brief Main loop of the highest label push-relabel algorithm.
      * 
-     *
-     *
-     * @tparam T Flow type.
-     * @param graph The residual network.
-     * @return The value of a maximum flow.
+     * @param stopper Checked after every discharge (Stopper or NoStop).
+     * @return The value of a maximum flow (flow into t of the preflow if stopped).
      */
-    template <typename T>
-    T hi_push_relabel(ds::Graph<T>& graph) {
+    template <typename T, typename I>
+    T _hi_push_relabel(ds::Graph<T, I>& graph, PushRelabelWorkspace<T, I>& workspace, auto& stopper) {
         // initialization
         auto& adj_list{graph.m_adj_list};
+        workspace.prepare(graph);
 
-        // labels (or heights), all 0 except for the source at n (#vertices in the graph)
-        std::vector<int> labels(graph.m_n, 0);
-        labels[graph.m_s] = graph.m_n;
+        // labels (or heights), all 0 except for the sources at n (#vertices in the graph)
+        auto& labels{workspace.m_labels};
 
         // "current-arc" suggested by wikipedia.
         // https://en.wikipedia.org/wiki/Push–relabel_maximum_flow_algorithm
-        std::vector<int> current_edges(graph.m_n, 0);
+        auto& current_edges{workspace.m_current_edges};
 
         // excess function
-        std::vector<T> excess(graph.m_n, 0);
-        excess[graph.m_s] = std::numeric_limits<T>::max();
+        auto& excess{workspace.m_excess};
 
         // active nodes are now stored into buckets indexed by their labels
         // process active nodes from highest to lowest label (all 0 at the start)
-        std::vector<std::queue<int>> active(2*graph.m_n, std::queue<int>{});
+        auto& active{workspace.m_buckets};
+        active.reset(2*graph.m_n, graph.m_n);
 
         // preflow + correct buckets of labels initialization
         initialize_buckets(graph, excess, active, labels);
-        int highest{0};
+        I highest{0};
         
         // gap heuristic from wikipedia. gap[i] = number of vertices with label i
-        std::vector<int> gap(2*graph.m_n, 0);
-        gap[graph.m_s] = graph.m_n-1;
+        auto& gap{workspace.m_gap};
+        reset_prefix(gap, 2*graph.m_n, I{0});
+        // all vertices but the sources start at label 0
+        gap[0] = graph.m_n - static_cast<I>(graph.sources().size());
 
         // similar to the main loop of the generic push-relabel
         while(true) {
             // get the next active node with the highest label
-            while(active[highest].empty()) {
+            while(active.empty(highest)) {
                 if(highest == 0) {
-                    return excess[graph.m_t];
+                    return sink_excess(graph, excess);
                 }
                 --highest;
             }
-            int vertex{active[highest].front()};
-            active[highest].pop();
+            I vertex{active.front(highest)};
+            active.pop(highest);
             // usual discharge operation
-            if(vertex == graph.m_s || vertex == graph.m_t) { continue; }
+            if(graph.is_source(vertex) || graph.is_sink(vertex)) { continue; }
             while(excess[vertex] > 0) {
                 // node still active, but reached end of edges -> relabel node, update gaps
-                if(current_edges[vertex] == adj_list[vertex].size()) {
+                if(current_edges[vertex] == static_cast<I>(adj_list[vertex].size())) {
                     current_edges[vertex] = relabel(graph, vertex, labels);
                     ++counters::hi_pr_relabels;
                     //update gap heuristic
                     --gap[highest];
                     ++gap[labels[vertex]];
                     if(labels[vertex] < graph.m_n && gap[highest] == 0) {
-                        for(int i{0}; i < graph.m_n; ++i) {
+                        for(I i{0}; i < graph.m_n; ++i) {
                             // vertices can't be activated
                             if(highest < labels[i] && labels[i] < graph.m_n) {
                                 --gap[labels[i]];
@@ -110,7 +111,7 @@ namespace algorithms {
                     auto* edge{adj_list[vertex][current_edges[vertex]]};
                     if(edge->capacity > 0 && labels[vertex] == labels[edge->head]+1) {
                         if(push(excess, edge)) {
-                            active[labels[edge->head]].push(edge->head);
+                            active.push(labels[edge->head], edge->head);
                             ++counters::hi_pr_pushes;
                         }
                     } else {
@@ -118,8 +119,62 @@ namespace algorithms {
                     }
                 }
             }
+            if(stopper.stop([&]() { return sink_excess(graph, excess); })) { return sink_excess(graph, excess); }
         }
     }
+
+    /**
+     * @brief Computes the maximum flow in a given flow network using 
+     *        Goldberg's and Tarjan's push-relabel algorithm and the
+     *        highest label selection rule.
+     * 
+     *
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return The value of a maximum flow.
+     */
+    template <typename T, typename I>
+    T hi_push_relabel(ds::Graph<T, I>& graph) {
+        PushRelabelWorkspace<T, I> workspace{};
+        return hi_push_relabel(graph, workspace);
+    }
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T hi_push_relabel(ds::Graph<T, I>& graph, PushRelabelWorkspace<T, I>& workspace) {
+        NoStop no_stop{};
+        return _hi_push_relabel(graph, workspace, no_stop);
+    }
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> hi_push_relabel(ds::Graph<T, I>& graph, PushRelabelWorkspace<T, I>& workspace, const SolveOptions<T>& options) {
+        // a discharge is far cheaper than reading the clock
+        Stopper<T, I> stopper{graph, options, 64};
+        T flow{_hi_push_relabel(graph, workspace, stopper)};
+        return make_result(graph, flow, stopper.status());
+    }
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> hi_push_relabel(ds::Graph<T, I>& graph, const SolveOptions<T>& options) {
+        PushRelabelWorkspace<T, I> workspace{};
+        return hi_push_relabel(graph, workspace, options);
+    }
 }
 
 #endif
\ No newline at end of file
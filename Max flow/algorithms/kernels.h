@@ -0,0 +1,78 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstddef>
+#include <utility>
+
+/**
+ * Vectorized versions of the hot per-edge scans (relabel of push-relabel, bfs of
+ * dinic's) for vertices with many edges. The edge fields are gathered through the
+ * pointers of the adjacency list. The instruction set is picked at runtime,
+ * falling back to plain loops. Only int indices are vectorized, with int or long long flow.
+ */
+namespace algorithms {
+
+    namespace kernels {
+
+        enum class SimdLevel {
+            scalar,
+            avx2,
+            avx512
+        };
+
+        /**
+         * @brief The best instruction set supported by the cpu.
+         */
+        inline SimdLevel detect_simd_level();
+
+        /**
+         * @brief Highest level the kernels may use, lower it to compare with the scalar loops.
+         */
+        inline SimdLevel max_simd_level{SimdLevel::avx512};
+
+        /**
+         * @brief The level used by the kernels: the detected one, at most max_simd_level.
+         */
+        inline SimdLevel simd_level();
+
+        /**
+         * @brief Vertices with fewer edges are scanned with the plain loops.
+         */
+        inline constexpr std::size_t simd_min_degree{16};
+
+        /**
+         * @brief Finds the minimal label over all edges with positive residual capacity.
+         * 
+         * @tparam Edge Edge type of the graph.
+         * @tparam I Index type.
+         * @param edges The edges of a vertex.
+         * @param count Number of edges.
+         * @param labels Label of each vertex.
+         * @return std::pair<I, I> (minimal label, index of the first edge with it), 
+         *         (max of I, 0) if no edge has residual capacity.
+         */
+        template <typename Edge, typename I>
+        std::pair<I, I> min_residual_label(Edge* const* edges, std::size_t count, const I* labels);
+
+        /**
+         * @brief Collects the edges with positive residual capacity whose head is not
+         *        stamped with the given epoch (see VisitedMarks).
+         * 
+         * @tparam Edge Edge type of the graph.
+         * @tparam I Index type.
+         * @param edges The edges of a vertex.
+         * @param count Number of edges.
+         * @param stamps Stamp of each vertex.
+         * @param epoch The current epoch.
+         * @param out Receives the indices of the edges found, in increasing order (room for count).
+         * @return std::size_t The number of edges found. Heads can repeat.
+         */
+        template <typename Edge, typename I>
+        std::size_t collect_unreached(Edge* const* edges, std::size_t count, 
+                const unsigned int* stamps, unsigned int epoch, I* out);
+    }
+}
+
+#include "kernels.ipp"
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef KERNELS_IPP
+#define KERNELS_IPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MAX_FLOW_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace algorithms {
+
+    namespace kernels {
+
+        /**
+         * @brief The best instruction set supported by the cpu.
+         */
+        inline SimdLevel detect_simd_level() {
+#ifdef MAX_FLOW_X86_KERNELS
+            static const SimdLevel detected{[]() {
+                __builtin_cpu_init();
+                if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")) { return SimdLevel::avx512; }
+                if(__builtin_cpu_supports("avx2")) { return SimdLevel::avx2; }
+                return SimdLevel::scalar;
+            }()};
+            return detected;
+#else
+            return SimdLevel::scalar;
+#endif
+        }
+
+        /**
+         * @brief The level used by the kernels: the detected one, at most max_simd_level.
+         */
+        inline SimdLevel simd_level() {
+            SimdLevel detected{detect_simd_level()};
+            return detected < max_simd_level ? detected : max_simd_level;
+        }
+
+        template <typename Edge, typename I>
+        std::pair<I, I> min_residual_label_scalar(Edge* const* edges, std::size_t count, const I* labels) {
+            I min_label{std::numeric_limits<I>::max()};
+            I edge_index{0};
+            for(std::size_t i{0}; i < count; ++i) {
+                if(edges[i]->capacity > 0 && labels[edges[i]->head] < min_label) {
+                    min_label = labels[edges[i]->head];
+                    edge_index = static_cast<I>(i);
+                }
+            }
+            return {min_label, edge_index};
+        }
+
+        template <typename Edge, typename I>
+        std::size_t collect_unreached_scalar(Edge* const* edges, std::size_t count,
+                const unsigned int* stamps, unsigned int epoch, I* out) {
+            std::size_t found{0};
+            for(std::size_t i{0}; i < count; ++i) {
+                if(edges[i]->capacity > 0 && stamps[edges[i]->head] != epoch) {
+                    out[found++] = static_cast<I>(i);
+                }
+            }
+            return found;
+        }
+
+#ifdef MAX_FLOW_X86_KERNELS
+
+        /**
+         * @brief Whether the vectorized kernels apply to the edge and index type
+         *        (int indices, int or long long capacities, 64 bit pointers).
+         */
+        template <typename Edge, typename I>
+        constexpr bool vectorizable() {
+            using C = std::remove_cv_t<decltype(Edge::capacity)>;
+            return std::is_same_v<I, int> && std::is_same_v<std::remove_cv_t<decltype(Edge::head)>, int>
+                && (std::is_same_v<C, int> || std::is_same_v<C, long long>) && sizeof(Edge*) == 8;
+        }
+
+        /**
+         * @brief Gathers the heads and whether the residual capacity is positive (all bits set)
+         *        of 4 edges through their pointers.
+         */
+        template <typename Edge>
+        __attribute__((target("avx2")))
+        void gather_edges_avx2(Edge* const* edges, __m128i& heads, __m128i& residual) {
+            const int* base{nullptr};
+            __m256i pointers{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(edges))};
+            heads = _mm256_i64gather_epi32(base, _mm256_add_epi64(pointers, _mm256_set1_epi64x(offsetof(Edge, head))), 1);
+            __m256i capacity_addresses{_mm256_add_epi64(pointers, _mm256_set1_epi64x(offsetof(Edge, capacity)))};
+            if constexpr(std::is_same_v<decltype(Edge::capacity), int>) {
+                __m128i capacities{_mm256_i64gather_epi32(base, capacity_addresses, 1)};
+                residual = _mm_cmpgt_epi32(capacities, _mm_setzero_si128());
+            } else {
+                __m256i capacities{_mm256_i64gather_epi64(reinterpret_cast<const long long*>(base), capacity_addresses, 1)};
+                __m256i wide{_mm256_cmpgt_epi64(capacities, _mm256_setzero_si256())};
+                // the lower halves of the 64 bit lanes hold the mask
+                residual = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(wide, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0)));
+            }
+        }
+
+        /**
+         * @brief Same as gather_edges_avx2 for 8 edges.
+         */
+        template <typename Edge>
+        __attribute__((target("avx512f,avx2")))
+        void gather_edges_avx512(Edge* const* edges, __m256i& heads, __m256i& residual) {
+            // masked gathers with all lanes set, the unmasked ones start from an undefined vector
+            const __mmask8 all{0xFF};
+            __m512i pointers{_mm512_loadu_si512(edges)};
+            heads = _mm512_mask_i64gather_epi32(_mm256_setzero_si256(), all,
+                _mm512_add_epi64(pointers, _mm512_set1_epi64(offsetof(Edge, head))), nullptr, 1);
+            __m512i capacity_addresses{_mm512_add_epi64(pointers, _mm512_set1_epi64(offsetof(Edge, capacity)))};
+            if constexpr(std::is_same_v<decltype(Edge::capacity), int>) {
+                __m256i capacities{_mm512_mask_i64gather_epi32(_mm256_setzero_si256(), all, capacity_addresses, nullptr, 1)};
+                residual = _mm256_cmpgt_epi32(capacities, _mm256_setzero_si256());
+            } else {
+                __m512i capacities{_mm512_mask_i64gather_epi64(_mm512_setzero_si512(), all, capacity_addresses, nullptr, 1)};
+                __mmask8 positive{_mm512_cmpgt_epi64_mask(capacities, _mm512_setzero_si512())};
+                residual = _mm512_mask_cvtepi64_epi32(_mm256_setzero_si256(), positive, _mm512_set1_epi64(-1));
+            }
+        }
+
+        /**
+         * @brief Picks the smallest label of the lanes, ties go to the smallest edge index.
+         */
+        inline std::pair<int, int> reduce_lanes(const int* best, const int* best_index, int lanes) {
+            int min_label{std::numeric_limits<int>::max()};
+            int edge_index{0};
+            for(int lane{0}; lane < lanes; ++lane) {
+                if(best[lane] == std::numeric_limits<int>::max()) { continue; }
+                if(best[lane] < min_label || (best[lane] == min_label && best_index[lane] < edge_index)) {
+                    min_label = best[lane];
+                    edge_index = best_index[lane];
+                }
+            }
+            return {min_label, edge_index};
+        }
+
+        /**
+         * @brief Scans the edges the vector loop left over, they come after all lanes
+         *        so only strictly smaller labels win.
+         */
+        template <typename Edge>
+        std::pair<int, int> min_residual_label_tail(Edge* const* edges, std::size_t i, std::size_t count,
+                const int* labels, std::pair<int, int> result) {
+            for(; i < count; ++i) {
+                if(edges[i]->capacity > 0 && labels[edges[i]->head] < result.first) {
+                    result = {labels[edges[i]->head], static_cast<int>(i)};
+                }
+            }
+            return result;
+        }
+
+        template <typename Edge>
+        __attribute__((target("avx2")))
+        std::pair<int, int> min_residual_label_avx2(Edge* const* edges, std::size_t count, const int* labels) {
+            const __m128i none{_mm_set1_epi32(std::numeric_limits<int>::max())};
+            __m128i best{none};
+            __m128i best_index{_mm_setzero_si128()};
+            __m128i index{_mm_setr_epi32(0, 1, 2, 3)};
+            std::size_t i{0};
+            for(; i+4 <= count; i += 4) {
+                __m128i heads, residual;
+                gather_edges_avx2(edges+i, heads, residual);
+                // edges without residual capacity keep the "infinite" label
+                __m128i head_labels{_mm_mask_i32gather_epi32(none, labels, heads, residual, 4)};
+                __m128i smaller{_mm_cmpgt_epi32(best, head_labels)};
+                best = _mm_blendv_epi8(best, head_labels, smaller);
+                best_index = _mm_blendv_epi8(best_index, index, smaller);
+                index = _mm_add_epi32(index, _mm_set1_epi32(4));
+            }
+            alignas(16) int lane_best[4];
+            alignas(16) int lane_index[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lane_best), best);
+            _mm_store_si128(reinterpret_cast<__m128i*>(lane_index), best_index);
+            return min_residual_label_tail(edges, i, count, labels, reduce_lanes(lane_best, lane_index, 4));
+        }
+
+        template <typename Edge>
+        __attribute__((target("avx512f,avx2")))
+        std::pair<int, int> min_residual_label_avx512(Edge* const* edges, std::size_t count, const int* labels) {
+            const __m256i none{_mm256_set1_epi32(std::numeric_limits<int>::max())};
+            __m256i best{none};
+            __m256i best_index{_mm256_setzero_si256()};
+            __m256i index{_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)};
+            std::size_t i{0};
+            for(; i+8 <= count; i += 8) {
+                __m256i heads, residual;
+                gather_edges_avx512(edges+i, heads, residual);
+                __m256i head_labels{_mm256_mask_i32gather_epi32(none, labels, heads, residual, 4)};
+                __m256i smaller{_mm256_cmpgt_epi32(best, head_labels)};
+                best = _mm256_blendv_epi8(best, head_labels, smaller);
+                best_index = _mm256_blendv_epi8(best_index, index, smaller);
+                index = _mm256_add_epi32(index, _mm256_set1_epi32(8));
+            }
+            alignas(32) int lane_best[8];
+            alignas(32) int lane_index[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lane_best), best);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lane_index), best_index);
+            return min_residual_label_tail(edges, i, count, labels, reduce_lanes(lane_best, lane_index, 8));
+        }
+
+        template <typename Edge>
+        __attribute__((target("avx2")))
+        std::size_t collect_unreached_avx2(Edge* const* edges, std::size_t count,
+                const unsigned int* stamps, unsigned int epoch, int* out) {
+            const __m128i current{_mm_set1_epi32(static_cast<int>(epoch))};
+            const int* stamp_base{reinterpret_cast<const int*>(stamps)};
+            std::size_t found{0};
+            std::size_t i{0};
+            for(; i+4 <= count; i += 4) {
+                __m128i heads, residual;
+                gather_edges_avx2(edges+i, heads, residual);
+                // edges without residual capacity look reached
+                __m128i head_stamps{_mm_mask_i32gather_epi32(current, stamp_base, heads, residual, 4)};
+                int reached{_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(head_stamps, current)))};
+                for(int lanes{~reached & 0xF}; lanes; lanes &= lanes-1) {
+                    out[found++] = static_cast<int>(i) + __builtin_ctz(lanes);
+                }
+            }
+            for(; i < count; ++i) {
+                if(edges[i]->capacity > 0 && stamps[edges[i]->head] != epoch) {
+                    out[found++] = static_cast<int>(i);
+                }
+            }
+            return found;
+        }
+
+#else
+
+        template <typename Edge, typename I>
+        constexpr bool vectorizable() { return false; }
+
+#endif
+
+        template <typename Edge, typename I>
+        std::pair<I, I> min_residual_label(Edge* const* edges, std::size_t count, const I* labels) {
+#ifdef MAX_FLOW_X86_KERNELS
+            if constexpr(vectorizable<Edge, I>()) {
+                switch(simd_level()) {
+                    case SimdLevel::avx512: return min_residual_label_avx512(edges, count, labels);
+                    case SimdLevel::avx2: return min_residual_label_avx2(edges, count, labels);
+                    case SimdLevel::scalar: break;
+                }
+            }
+#endif
+            return min_residual_label_scalar(edges, count, labels);
+        }
+
+        template <typename Edge, typename I>
+        std::size_t collect_unreached(Edge* const* edges, std::size_t count,
+                const unsigned int* stamps, unsigned int epoch, I* out) {
+#ifdef MAX_FLOW_X86_KERNELS
+            // 8 wide gathers do not pay off for the short runs of unreached heads
+            if constexpr(vectorizable<Edge, I>()) {
+                if(simd_level() != SimdLevel::scalar) {
+                    return collect_unreached_avx2(edges, count, stamps, epoch, out);
+                }
+            }
+#endif
+            return collect_unreached_scalar(edges, count, stamps, epoch, out);
+        }
+    }
+}
+
+#endif
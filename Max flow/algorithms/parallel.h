@@ -0,0 +1,36 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+
+namespace algorithms {
+
+    namespace utils {
+
+        /**
+         * @brief Number of threads to use if 0 is requested. (all hardware threads)
+         * 
+         * @param num_threads The requested number of threads.
+         * @return unsigned The number of threads actually used, at least 1.
+         */
+        inline unsigned thread_count(unsigned num_threads);
+
+        /**
+         * @brief Splits [begin, end) into num_threads contiguous blocks and calls
+         *        body(thread_id, block_begin, block_end) for each block on its own thread.
+         *
+         *        The split only depends on the range and the number of threads, so
+         *        results written by index are deterministic.
+         * 
+         * @param begin First index.
+         * @param end One past the last index.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @param body The function called on every block.
+         */
+        void parallel_for(std::size_t begin, std::size_t end, unsigned num_threads, auto&& body);
+    }
+}
+
+#include "parallel.ipp"
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef PARALLEL_IPP
+#define PARALLEL_IPP
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace algorithms {
+
+    namespace utils {
+
+        /**
+         * @brief Number of threads to use if 0 is requested. (all hardware threads)
+         * 
+         * @param num_threads The requested number of threads.
+         * @return unsigned The number of threads actually used, at least 1.
+         */
+        inline unsigned thread_count(unsigned num_threads) {
+            if(num_threads == 0) {
+                num_threads = std::thread::hardware_concurrency();
+            }
+            return std::max(num_threads, 1u);
+        }
+
+        /**
+         * @brief Splits [begin, end) into num_threads contiguous blocks and calls
+         *        body(thread_id, block_begin, block_end) for each block on its own thread.
+         * 
+         * @param begin First index.
+         * @param end One past the last index.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @param body The function called on every block.
+         */
+        void parallel_for(std::size_t begin, std::size_t end, unsigned num_threads, auto&& body) {
+            if(end <= begin) { return; }
+            std::size_t size{end - begin};
+            std::size_t blocks{std::min<std::size_t>(thread_count(num_threads), size)};
+            // not worth starting a thread
+            if(blocks == 1) {
+                body(0u, begin, end);
+                return;
+            }
+            std::vector<std::thread> threads{};
+            threads.reserve(blocks-1);
+            for(std::size_t i{1}; i < blocks; ++i) {
+                threads.emplace_back([&body, i, begin, size, blocks]() {
+                    body(static_cast<unsigned>(i), begin + size*i/blocks, begin + size*(i+1)/blocks);
+                });
+            }
+            // the calling thread takes the first block
+            body(0u, begin, begin + size/blocks);
+            for(auto& thread : threads) {
+                thread.join();
+            }
+        }
+    }
+}
+
+#endif
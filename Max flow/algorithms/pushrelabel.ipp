@@ -2,12 +2,15 @@
 #define PUSH_RELABEL_IPP
 
 #include "../data structures/graph.h"
+#include "workspace.h"
+#include "anytime.h"
 #include "counter.h"
+#include "kernels.h"
 
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <chrono>
+#include <limits>
 
 namespace algorithms {
 
@@ -33,44 +36,84 @@ namespace algorithms {
         return to_push && to_push == excess[edge->head];
     }
 
+    /**
+     * @brief Saturates an edge leaving a source, the excess of the source becomes negative.
+     * 
+     * @tparam T Flow type.
+     * @param excess The sum of ingoing flow for every vertex. (negative for outgoing flow).
+     * @param edge The edge to saturate.
+     * @return returns true if the head got active.
+     */
+    template <typename T>
+    bool saturate(std::vector<T>& excess, auto* edge) {
+        T to_push{edge->capacity};
+        excess[edge->tail] -= to_push;
+        excess[edge->head] += to_push;
+        edge->capacity = 0;
+        edge->reverse->capacity += to_push;
+        return to_push > 0 && to_push == excess[edge->head];
+    }
+
     /**
      * @brief Initializes the preflow for the push-relabel algorithm.
      * 
-     *        Sends as much flow es possible from every outgoing edge of the source.
+     *        Sends as much flow es possible from every outgoing edge of the sources.
      * 
      *
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
      * @param excess The sum of ingoing flow for every vertex. (negative for outgoing flow)
      * @param active Queue of active vertices.
      */
-    template <typename T>
-    void initialize_preflow(ds::Graph<T>& graph, std::vector<T>& excess, std::queue<int>& active) {
-        for(auto* edge : graph.m_adj_list[graph.m_s]) {
-            // saturate each outgoing edge from s
-            if(push(excess, edge)) {
-                active.push(edge->head);
+    template <typename T, typename I>
+    void initialize_preflow(ds::Graph<T, I>& graph, std::vector<T>& excess, RingQueue<I>& active) {
+        for(I source : graph.sources()) {
+            for(auto* edge : graph.m_adj_list[source]) {
+                // saturate each outgoing edge, flow between sources is useless
+                if(!graph.is_source(edge->head) && saturate(excess, edge)) {
+                    active.push(edge->head);
+                }
             }
         }
     }
 
+    /**
+     * @brief The flow value of the preflow, the excess of all sinks.
+     */
+    template <typename T, typename I>
+    T sink_excess(const ds::Graph<T, I>& graph, const std::vector<T>& excess) {
+        T flow{0};
+        for(I sink : graph.sinks()) {
+            flow += excess[sink];
+        }
+        return flow;
+    }
+
     /**
      * @brief Assigns a new label to the given vertex.
      * 
      *        The new label is the minimal label of all adjacent vertices + 1
      * 
      * @tparam T Flow type.
+     * @tparam I Index type.
      * @param graph The residual network.
      * @param vertex The vertex to relabel.
      * @param labels Current labeling.
      * @return The index of the edge used to find the minimal labeling (push operations can only start at this edge)
      */
-    template <typename T>
-    int relabel(ds::Graph<T>& graph, int vertex, std::vector<int>& labels) {
-        int min_label{INT_MAX};
-        int edge_index{0};
-        for(int i{0}; i < graph.m_adj_list[vertex].size(); ++i) {
-            auto* edge{graph.m_adj_list[vertex][i]};
+    template <typename T, typename I>
+    I relabel(ds::Graph<T, I>& graph, I vertex, std::vector<I>& labels) {
+        auto edges{graph.m_adj_list[vertex]};
+        if(edges.size() >= kernels::simd_min_degree) {
+            auto [min_label, edge_index]{kernels::min_residual_label(edges.data(), edges.size(), labels.data())};
+            labels[vertex] = min_label+1;
+            return edge_index;
+        }
+        I min_label{std::numeric_limits<I>::max()};
+        I edge_index{0};
+        for(I i{0}; i < static_cast<I>(edges.size()); ++i) {
+            auto* edge{edges[i]};
             if(edge->capacity > 0) {
                 if(labels[edge->head] < min_label) {
                     min_label = labels[edge->head];
@@ -83,46 +126,41 @@ namespace algorithms {
     }
 
     /**
-     * @brief Computes the value of a maximum flow in the given graph using 
-     *        Goldberg's and Tarjan's push-relabel algorithm.
+     * @brief Main loop of the push-relabel algorithm.
      * 
-     *
-     * @tparam T Flow type.
-     * @param graph The residual network.
-     * @return The value of a maximum flow.
+     * @param stopper Checked after every discharge (Stopper or NoStop).
+     * @return The value of a maximum flow (flow into t of the preflow if stopped).
      */
-    template <typename T>
-    T push_relabel(ds::Graph<T>& graph) {
+    template <typename T, typename I>
+    T _push_relabel(ds::Graph<T, I>& graph, PushRelabelWorkspace<T, I>& workspace, auto& stopper) {
         // initialization
         auto& adj_list{graph.m_adj_list};
+        workspace.prepare(graph);
 
-
-        // labels (or heights), all 0 except for the source at n (#vertices in the graph)
-        std::vector<int> labels(graph.m_n, 0);
-        labels[graph.m_s] = graph.m_n;
+        // labels (or heights), all 0 except for the sources at n (#vertices in the graph)
+        auto& labels{workspace.m_labels};
 
         // "current-arc" data structure proposed by wikipedia 
         //https://en.wikipedia.org/wiki/Push–relabel_maximum_flow_algorithm
-        std::vector<int> current_edges(graph.m_n, 0);
+        auto& current_edges{workspace.m_current_edges};
 
         // excess function
-        std::vector<T> excess(graph.m_n, 0);
-        excess[graph.m_s] = std::numeric_limits<T>::max();
+        auto& excess{workspace.m_excess};
 
         // queue of active vertices
-        std::queue<int> active{};
+        auto& active{workspace.m_active};
         // initialize preflow
         initialize_preflow(graph, excess, active);
 
         // main push-relabel
         while(!active.empty()) {
-            int vertex{active.front()};
+            I vertex{active.front()};
             active.pop();
-            if(vertex == graph.m_s || vertex == graph.m_t) { continue; }
+            if(graph.is_source(vertex) || graph.is_sink(vertex)) { continue; }
             // discharge operation defined on wikipedia
             while(excess[vertex] > 0) {
                 // node still active, but reached end of edges -> relabel
-                if(current_edges[vertex] == adj_list[vertex].size()) {
+                if(current_edges[vertex] == static_cast<I>(adj_list[vertex].size())) {
                     current_edges[vertex] = relabel(graph, vertex, labels);
                     ++counters::pr_relabels;
                 } else {
@@ -137,8 +175,61 @@ namespace algorithms {
                     }
                 }
             }
+            // summing the sinks only when the stopper looks at the flow
+            if(stopper.stop([&]() { return sink_excess(graph, excess); })) { break; }
         }
-        return excess[graph.m_t];
+        return sink_excess(graph, excess);
+    }
+
+    /**
+     * @brief Computes the value of a maximum flow in the given graph using 
+     *        Goldberg's and Tarjan's push-relabel algorithm.
+     * 
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return The value of a maximum flow.
+     */
+    template <typename T, typename I>
+    T push_relabel(ds::Graph<T, I>& graph) {
+        PushRelabelWorkspace<T, I> workspace{};
+        return push_relabel(graph, workspace);
+    }
+
+    /**
+     * @brief Same as above, reusing the buffers of the given workspace.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     */
+    template <typename T, typename I>
+    T push_relabel(ds::Graph<T, I>& graph, PushRelabelWorkspace<T, I>& workspace) {
+        NoStop no_stop{};
+        return _push_relabel(graph, workspace, no_stop);
+    }
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     * 
+     * @param workspace Buffers, can be reused for any number of solves.
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    SolveResult<T> push_relabel(ds::Graph<T, I>& graph, PushRelabelWorkspace<T, I>& workspace, const SolveOptions<T>& options) {
+        // a discharge is far cheaper than reading the clock
+        Stopper<T, I> stopper{graph, options, 64};
+        T flow{_push_relabel(graph, workspace, stopper)};
+        return make_result(graph, flow, stopper.status());
+    }
+
+    /**
+     * @brief Anytime version with its own workspace.
+     */
+    template <typename T, typename I>
+    SolveResult<T> push_relabel(ds::Graph<T, I>& graph, const SolveOptions<T>& options) {
+        PushRelabelWorkspace<T, I> workspace{};
+        return push_relabel(graph, workspace, options);
     }
 }
 
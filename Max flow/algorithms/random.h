@@ -17,6 +17,15 @@ namespace algorithms {
                 Random();
                 Random(unsigned int seed);
 
+                /**
+                 * @brief Independent stream derived from (seed, stream). Used to give
+                 *        every thread/frame of a generator its own deterministic numbers.
+                 * 
+                 * @param seed The seed shared by all streams.
+                 * @param stream The index of the stream.
+                 */
+                Random(unsigned int seed, unsigned int stream);
+
                 /**
                  * @brief Generate a random number in [l, h].
                  * 
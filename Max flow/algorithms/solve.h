@@ -0,0 +1,192 @@
+#ifndef SOLVE_H
+#define SOLVE_H
+
+#include "../data structures/graph.h"
+#include "anytime.h"
+#include "verify.h"
+
+#include <string>
+#include <string_view>
+
+/**
+ * Automatic solver selection: solve(graph) computes a few features of the network in
+ * linear time, picks the engine expected to be fastest with a fixed rule set (calibrated
+ * with the benchmark harness on generated and random families) and reports the engine
+ * and the rule that chose it together with the result.
+ */
+namespace algorithms {
+
+    /**
+     * @brief The algorithms solve can choose from.
+     */
+    enum class Engine {
+        ford_fulkerson,
+        edmonds_karp,
+        edmonds_karp_bidirectional,
+        dinic,
+        dinic_dynamic_trees,
+        push_relabel,
+        hi_push_relabel
+    };
+
+    /**
+     * @brief Name of the engine, as printed by the benchmark.
+     */
+    inline std::string_view engine_name(Engine engine);
+
+    /**
+     * @brief What the engine leaves in the residual network, for verify_max_flow.
+     */
+    inline FlowKind flow_kind(Engine engine);
+
+    /**
+     * @brief Features of a network, all computed in O(n + m).
+     *
+     *        Arcs are edges with capacity in the input (an undirected edge counts as two
+     *        arcs), inner vertices are the vertices that are neither sources nor sinks.
+     */
+    template <typename T>
+    struct GraphFeatures {
+        std::size_t vertices{0};
+        std::size_t arcs{0};
+
+        /**
+         * @brief Out-degree (in arcs): average, maximum and standard deviation.
+         */
+        double average_degree{0};
+        std::size_t max_degree{0};
+        double degree_deviation{0};
+
+        /**
+         * @brief Smallest and largest capacity of an arc.
+         */
+        T min_capacity{0};
+        T max_capacity{0};
+        bool unit_capacity{false};
+
+        /**
+         * @brief Whether the inner vertices with the arcs between them form a bipartite graph.
+         */
+        bool bipartite{false};
+
+        /**
+         * @brief min(#arcs leaving the sources, #arcs entering the sinks), bounds
+         *        the number of augmenting paths on unit capacities.
+         */
+        std::size_t terminal_degree{0};
+
+        /**
+         * @brief Number of arcs on a shortest path from a source to a sink, -1 if there is none.
+         */
+        long long st_distance{-1};
+    };
+
+    /**
+     * @brief The engine chosen for a network and why.
+     */
+    struct EngineChoice {
+        Engine engine{Engine::hi_push_relabel};
+
+        /**
+         * @brief The rule that chose the engine, with the feature values it looked at.
+         */
+        std::string reason{};
+    };
+
+    /**
+     * @brief Result of solve: the result of the engine, plus which engine ran and why.
+     */
+    template <typename T>
+    struct AutoSolveResult : SolveResult<T> {
+        EngineChoice choice{};
+        GraphFeatures<T> features{};
+    };
+
+    /**
+     * @brief Computes the features of the network (from the current residual capacities).
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return GraphFeatures<T> The features.
+     */
+    template <typename T, typename I>
+    GraphFeatures<T> graph_features(const ds::Graph<T, I>& graph);
+
+    /**
+     * @brief Picks the engine expected to be fastest on a network with the given features.
+     *
+     *        The first matching rule wins:
+     *        1. no source-sink path: bidirectional edmonds-karp, a single search.
+     *        2. path-like networks, at most 2 arcs out of every vertex and fewer on average
+     *           (ak): fifo push-relabel, about 1.5x faster than highest label there.
+     *        3. at most 64 arcs at the terminals (256 on unit capacities) and a source-sink
+     *           distance of at most log2(n) + 2 (random networks): bidirectional edmonds-karp,
+     *           few augmenting paths that each touch a small part of the network, 10-100x
+     *           faster than any other engine. Long distances (genrmf, grids) are excluded.
+     *        4. unit capacities on a bipartite network with at most 4 arcs per vertex (sparse
+     *           matchings): dinic's, up to 4x faster than highest label when many vertices
+     *           stay unmatched.
+     *        5. anything else: highest label push-relabel with the gap heuristic, best or within
+     *           1.5x of the best on every other family measured, while the fifo variant and
+     *           the augmenting path algorithms are 10-100x off on some of them.
+     *
+     * @tparam T Flow type.
+     * @param features Features of the network.
+     * @return EngineChoice The engine and the rule that chose it.
+     */
+    template <typename T>
+    EngineChoice choose_engine(const GraphFeatures<T>& features);
+
+    /**
+     * @brief Runs the given engine on the graph.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @param engine The algorithm to run.
+     * @param options Nothing, or the SolveOptions of an anytime solve.
+     * @return T The value of a maximum flow, SolveResult<T> with options.
+     */
+    template <typename T, typename I>
+    auto run_engine(ds::Graph<T, I>& graph, Engine engine, const auto&... options);
+
+    /**
+     * @brief Computes the maximum flow with the engine choose_engine picks for the graph.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return AutoSolveResult<T> The value of a maximum flow, the engine, the reason and the features.
+     */
+    template <typename T, typename I>
+    AutoSolveResult<T> solve(ds::Graph<T, I>& graph);
+
+    /**
+     * @brief Same with features computed before (graph_features on the graph with its
+     *        original capacities), so repeated solves after restore skip that pass.
+     *
+     * @param features The features of the graph.
+     */
+    template <typename T, typename I>
+    AutoSolveResult<T> solve(ds::Graph<T, I>& graph, const GraphFeatures<T>& features);
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     *
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    AutoSolveResult<T> solve(ds::Graph<T, I>& graph, const SolveOptions<T>& options);
+
+    /**
+     * @brief Anytime version with features computed before.
+     */
+    template <typename T, typename I>
+    AutoSolveResult<T> solve(ds::Graph<T, I>& graph, const GraphFeatures<T>& features, const SolveOptions<T>& options);
+}
+
+#include "solve.ipp"
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef SOLVE_IPP
+#define SOLVE_IPP
+
+#include "../data structures/graph.h"
+#include "fordfulkerson.h"
+#include "edmondskarp.h"
+#include "dinic.h"
+#include "dinicdt.h"
+#include "pushrelabel.h"
+#include "hipushrelabel.h"
+#include "anytime.h"
+#include "verify.h"
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+namespace algorithms {
+
+    inline std::string_view engine_name(Engine engine) {
+        switch(engine) {
+            case Engine::ford_fulkerson: return "FORD-FULKERSON DFS";
+            case Engine::edmonds_karp: return "EDMONDS-KARP";
+            case Engine::edmonds_karp_bidirectional: return "EDMONDS-KARP BIDIRECTIONAL";
+            case Engine::dinic: return "DINIC'S";
+            case Engine::dinic_dynamic_trees: return "DINIC'S + DYNAMIC TREES";
+            case Engine::push_relabel: return "PUSH-RELABEL";
+            case Engine::hi_push_relabel: return "HIGHEST LABEL PUSH-RELABEL + GAP";
+        }
+        return "";
+    }
+
+    inline FlowKind flow_kind(Engine engine) {
+        // the push-relabel algorithms stop with a preflow of maximum value
+        bool push_relabel{engine == Engine::push_relabel || engine == Engine::hi_push_relabel};
+        return push_relabel ? FlowKind::preflow : FlowKind::flow;
+    }
+
+    /**
+     * @brief Computes the features of the network (from the current residual capacities).
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return GraphFeatures<T> The features.
+     */
+    template <typename T, typename I>
+    GraphFeatures<T> graph_features(const ds::Graph<T, I>& graph) {
+        GraphFeatures<T> features{};
+        I n{graph.m_n};
+        features.vertices = static_cast<std::size_t>(n);
+        if(n == 0) { return features; }
+        auto is_arc = [](const auto* edge) { return edge->back_up_capacity > 0; };
+        auto is_terminal = [&graph](I v) { return graph.is_source(v) || graph.is_sink(v); };
+
+        // degrees and capacities
+        features.min_capacity = std::numeric_limits<T>::max();
+        double square_sum{0};
+        for(I v{0}; v < n; ++v) {
+            std::size_t degree{0};
+            for(auto* edge : graph.m_adj_list[v]) {
+                if(!is_arc(edge)) { continue; }
+                ++degree;
+                features.min_capacity = std::min(features.min_capacity, edge->back_up_capacity);
+                features.max_capacity = std::max(features.max_capacity, edge->back_up_capacity);
+            }
+            features.arcs += degree;
+            features.max_degree = std::max(features.max_degree, degree);
+            square_sum += static_cast<double>(degree) * degree;
+        }
+        if(features.arcs == 0) { features.min_capacity = 0; }
+        features.unit_capacity = features.arcs > 0 && features.min_capacity == 1 && features.max_capacity == 1;
+        features.average_degree = static_cast<double>(features.arcs) / n;
+        features.degree_deviation = std::sqrt(std::max(0.0,
+            square_sum / n - features.average_degree * features.average_degree));
+
+        std::size_t source_arcs{0};
+        for(I source : graph.sources()) {
+            source_arcs += std::ranges::count_if(graph.m_adj_list[source], is_arc);
+        }
+        std::size_t sink_arcs{0};
+        for(I sink : graph.sinks()) {
+            // an arc into the sink is the reverse of an edge in its list
+            sink_arcs += std::ranges::count_if(graph.m_adj_list[sink],
+                [&is_arc](const auto* edge) { return is_arc(edge->reverse); });
+        }
+        features.terminal_degree = std::min(source_arcs, sink_arcs);
+
+        // 2-coloring of the inner vertices
+        auto connected = [&is_arc](const auto* edge) { return is_arc(edge) || is_arc(edge->reverse); };
+        std::vector<signed char> color(n, -1);
+        std::vector<I> to_visit{};
+        features.bipartite = true;
+        for(I v{0}; v < n && features.bipartite; ++v) {
+            if(is_terminal(v) || color[v] != -1) { continue; }
+            color[v] = 0;
+            to_visit.assign(1, v);
+            for(std::size_t i{0}; i < to_visit.size() && features.bipartite; ++i) {
+                I vertex{to_visit[i]};
+                for(auto* edge : graph.m_adj_list[vertex]) {
+                    if(!connected(edge) || is_terminal(edge->head)) { continue; }
+                    if(color[edge->head] == -1) {
+                        color[edge->head] = !color[vertex];
+                        to_visit.push_back(edge->head);
+                    } else if(color[edge->head] == color[vertex]) {
+                        features.bipartite = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // bfs from the sources to the closest sink
+        std::vector<long long> distance(n, -1);
+        to_visit.clear();
+        for(I source : graph.sources()) {
+            distance[source] = 0;
+            to_visit.push_back(source);
+        }
+        for(std::size_t i{0}; i < to_visit.size() && features.st_distance == -1; ++i) {
+            I vertex{to_visit[i]};
+            for(auto* edge : graph.m_adj_list[vertex]) {
+                if(edge->capacity <= 0 || distance[edge->head] != -1) { continue; }
+                distance[edge->head] = distance[vertex] + 1;
+                if(graph.is_sink(edge->head)) {
+                    features.st_distance = distance[edge->head];
+                    break;
+                }
+                to_visit.push_back(edge->head);
+            }
+        }
+        return features;
+    }
+
+    /**
+     * @brief Picks the engine expected to be fastest on a network with the given features.
+     *        See solve.h for the rules.
+     *
+     * @tparam T Flow type.
+     * @param features Features of the network.
+     * @return EngineChoice The engine and the rule that chose it.
+     */
+    template <typename T>
+    EngineChoice choose_engine(const GraphFeatures<T>& features) {
+        // thresholds measured with the benchmark harness (-O2), see solve.h
+        constexpr std::size_t few_terminal_arcs{64};
+        constexpr std::size_t few_unit_terminal_arcs{256};
+        constexpr double sparse_matching_degree{4};
+        auto n{static_cast<double>(std::max<std::size_t>(features.vertices, 2))};
+        auto short_distance{static_cast<long long>(std::log2(n)) + 2};
+        auto terminal_degree{std::to_string(features.terminal_degree)};
+        auto distance{std::to_string(features.st_distance)};
+
+        if(features.st_distance == -1) {
+            return {Engine::edmonds_karp_bidirectional, "no path from a source to a sink, one search proves it"};
+        }
+        if(features.max_degree <= 2 && features.average_degree < 2) {
+            return {Engine::push_relabel, "path-like network (at most 2 arcs out of every vertex, "
+                + std::to_string(features.average_degree) + " on average)"};
+        }
+        std::size_t terminal_limit{features.unit_capacity ? few_unit_terminal_arcs : few_terminal_arcs};
+        if(features.terminal_degree <= terminal_limit && features.st_distance <= short_distance) {
+            return {Engine::edmonds_karp_bidirectional, "few short augmenting paths (" + terminal_degree
+                + " arcs at the terminals, source-sink distance " + distance + " <= log2(n) + 2)"};
+        }
+        if(features.unit_capacity && features.bipartite && features.average_degree <= sparse_matching_degree) {
+            return {Engine::dinic, "sparse unit capacity bipartite network ("
+                + std::to_string(features.average_degree) + " arcs per vertex), a matching"};
+        }
+        return {Engine::hi_push_relabel, "general network (" + terminal_degree
+            + " arcs at the terminals, source-sink distance " + distance + ")"};
+    }
+
+    /**
+     * @brief Runs the given engine, the options (none or SolveOptions) are passed on.
+     */
+    template <typename T, typename I>
+    auto run_engine(ds::Graph<T, I>& graph, Engine engine, const auto&... options) {
+        switch(engine) {
+            case Engine::ford_fulkerson: return ford_fulkerson(graph, options...);
+            case Engine::edmonds_karp: return edmonds_karp(graph, options...);
+            case Engine::edmonds_karp_bidirectional: return edmonds_karp_bidirectional(graph, options...);
+            case Engine::dinic: return dinic(graph, options...);
+            case Engine::dinic_dynamic_trees: return dinic_dynamic_trees(graph, options...);
+            case Engine::push_relabel: return push_relabel(graph, options...);
+            case Engine::hi_push_relabel: break;
+        }
+        return hi_push_relabel(graph, options...);
+    }
+
+    /**
+     * @brief Computes the maximum flow with the engine choose_engine picks for the graph.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @return AutoSolveResult<T> The value of a maximum flow, the engine, the reason and the features.
+     */
+    template <typename T, typename I>
+    AutoSolveResult<T> solve(ds::Graph<T, I>& graph) {
+        return solve(graph, graph_features(graph));
+    }
+
+    /**
+     * @brief Same with features computed before, repeated solves after restore skip that pass.
+     *
+     * @param features The features of the graph.
+     */
+    template <typename T, typename I>
+    AutoSolveResult<T> solve(ds::Graph<T, I>& graph, const GraphFeatures<T>& features) {
+        AutoSolveResult<T> result{};
+        result.features = features;
+        result.choice = choose_engine(result.features);
+        result.flow = run_engine(graph, result.choice.engine);
+        // optimal, the flow is its own bound
+        result.upper_bound = result.flow;
+        return result;
+    }
+
+    /**
+     * @brief Anytime version, stops at the deadline, on cancellation or once within
+     *        the tolerance (see SolveOptions). The result holds the flow found and an upper bound.
+     *
+     * @param options When to stop and how to report progress.
+     */
+    template <typename T, typename I>
+    AutoSolveResult<T> solve(ds::Graph<T, I>& graph, const SolveOptions<T>& options) {
+        return solve(graph, graph_features(graph), options);
+    }
+
+    /**
+     * @brief Anytime version with features computed before.
+     */
+    template <typename T, typename I>
+    AutoSolveResult<T> solve(ds::Graph<T, I>& graph, const GraphFeatures<T>& features, const SolveOptions<T>& options) {
+        AutoSolveResult<T> result{};
+        result.features = features;
+        result.choice = choose_engine(result.features);
+        static_cast<SolveResult<T>&>(result) = run_engine(graph, result.choice.engine, options);
+        return result;
+    }
+}
+
+#endif
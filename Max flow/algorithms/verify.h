@@ -0,0 +1,77 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include "../data structures/graph.h"
+
+#include <string>
+
+/**
+ * Certificate checker: from the residual network left by any algorithm, checks that
+ * the flow respects the capacities, is conserved and is maximum, the last by finding
+ * a cut of the same capacity. Linear in the size of the network, so cheap enough to
+ * run after every solve.
+ */
+namespace algorithms {
+
+    /**
+     * @brief What the residual network has to hold.
+     */
+    enum class FlowKind {
+        // every vertex except sources and sinks conserves flow (ford-fulkerson, edmonds-karp, dinic's)
+        flow,
+        // vertices may keep excess (push-relabel, a preflow of maximum value)
+        preflow
+    };
+
+    template <typename T>
+    struct Certificate {
+        /**
+         * @brief Whether all checks passed.
+         */
+        bool valid{false};
+
+        /**
+         * @brief The first failed check, empty if valid.
+         */
+        std::string error{};
+
+        /**
+         * @brief Flow into the sinks (summed in a wider type, saturated at the limits of T).
+         */
+        T flow{0};
+
+        /**
+         * @brief Capacity (in the original network) of the cut separating the sources from the sinks,
+         *        saturated like flow.
+         */
+        T cut_capacity{0};
+    };
+
+    /**
+     * @brief Checks that the residual network holds a maximum flow of the given value.
+     *
+     *        Capacities: no residual capacity is negative and every edge and its reverse
+     *        keep the capacity they had together. Conservation: the net outflow, summed
+     *        over the adjacency list, is 0 at every vertex but the terminals (at most 0
+     *        for a preflow). Maximality: the cut given by a residual bfs from the sources
+     *        (for a preflow: into the sinks) separates sources and sinks and its capacity
+     *        equals the flow into the sinks, which has to equal the given value.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network after a solve (before restore).
+     * @param max_flow The value returned by the algorithm.
+     * @param kind Whether the algorithm leaves a flow or a preflow.
+     * @param num_threads Number of threads for the checks over all edges (0 = all hardware threads).
+     *                    Networks with fewer than 2^20 edges are always checked by one thread,
+     *                    starting threads there costs more than the checks.
+     * @return Certificate<T> The result of the checks.
+     */
+    template <typename T, typename I>
+    Certificate<T> verify_max_flow(const ds::Graph<T, I>& graph, T max_flow,
+            FlowKind kind = FlowKind::flow, unsigned num_threads = 0);
+}
+
+#include "verify.ipp"
+
+#endif
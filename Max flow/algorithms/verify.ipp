@@ -0,0 +1,157 @@
+#ifndef VERIFY_IPP
+#define VERIFY_IPP
+
+#include "../data structures/graph.h"
+#include "parallel.h"
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <limits>
+
+namespace algorithms {
+
+    /**
+     * @brief Marks the source side of the cut used by the certificate.
+     *
+     *        For a flow these are the vertices reachable from a source over edges with
+     *        residual capacity. A preflow can leave excess at vertices that are not reachable
+     *        from any source, so there it is the vertices that cannot reach a sink instead.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network.
+     * @param kind Whether the residual network holds a flow or a preflow.
+     * @return std::vector<char> side[v] = 1 iff v is on the source side.
+     */
+    template <typename T, typename I>
+    std::vector<char> residual_source_side(const ds::Graph<T, I>& graph, FlowKind kind) {
+        bool forward{kind == FlowKind::flow};
+        std::vector<char> reached(graph.m_n, 0);
+        std::vector<I> to_visit{};
+        for(I vertex : forward ? graph.sources() : graph.sinks()) {
+            reached[vertex] = 1;
+            to_visit.push_back(vertex);
+        }
+        for(std::size_t i{0}; i < to_visit.size(); ++i) {
+            I vertex{to_visit[i]};
+            for(auto* edge : graph.m_adj_list[vertex]) {
+                // searching backwards, the reverse edge leads from the head to the vertex
+                T residual{forward ? edge->capacity : edge->reverse->capacity};
+                if(residual <= 0 || reached[edge->head]) { continue; }
+                reached[edge->head] = 1;
+                to_visit.push_back(edge->head);
+            }
+        }
+        if(!forward) {
+            for(auto& side : reached) { side = !side; }
+        }
+        return reached;
+    }
+
+    /**
+     * @brief Checks that the residual network holds a maximum flow of the given value.
+     *
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     * @param graph The residual network after a solve (before restore).
+     * @param max_flow The value returned by the algorithm.
+     * @param kind Whether the algorithm leaves a flow or a preflow.
+     * @param num_threads Number of threads for the checks over all edges (0 = all hardware threads).
+     *                    Networks with fewer than 2^20 edges are always checked by one thread,
+     *                    starting threads there costs more than the checks.
+     * @return Certificate<T> The result of the checks.
+     */
+    template <typename T, typename I>
+    Certificate<T> verify_max_flow(const ds::Graph<T, I>& graph, T max_flow, FlowKind kind, unsigned num_threads) {
+        // sums of capacities in a wider type, a wrapped sum could equal the flow
+        using Sum = ds::CapacitySum<T>;
+        struct Partial {
+            std::string error{};
+            Sum sink_inflow{0};
+            Sum cut{0};
+        };
+        auto vertex_name = [&graph](I vertex) { return std::to_string(graph.original_id(vertex)+1); };
+        auto sum_name = [](Sum value) {
+            if(value >= std::numeric_limits<long long>::min() && value <= std::numeric_limits<long long>::max()) {
+                return std::to_string(static_cast<long long>(value));
+            }
+            return std::string{value < 0 ? "below " : "above "} + std::to_string(static_cast<long long>(
+                value < 0 ? std::numeric_limits<long long>::min() : std::numeric_limits<long long>::max()));
+        };
+        // stored in T in the certificate, saturated
+        auto saturated = [](Sum value) {
+            return static_cast<T>(std::clamp<Sum>(value, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()));
+        };
+        constexpr std::size_t parallel_min_edges{1 << 20};
+        unsigned threads{graph.num_edges() < parallel_min_edges ? 1u : utils::thread_count(num_threads)};
+        std::vector<Partial> partial(threads);
+        Certificate<T> certificate{};
+
+        // capacities, conservation and the flow into the sinks, each block keeps its first error
+        utils::parallel_for(0, graph.m_n, threads, [&](unsigned id, std::size_t begin, std::size_t end) {
+            auto& result{partial[id]};
+            for(std::size_t v{begin}; v < end; ++v) {
+                I vertex{static_cast<I>(v)};
+                Sum net_outflow{0};
+                for(auto* edge : graph.m_adj_list[vertex]) {
+                    if(result.error.empty() && (edge->capacity < 0 || Sum{edge->capacity} + edge->reverse->capacity
+                            != Sum{edge->back_up_capacity} + edge->reverse->back_up_capacity)) {
+                        result.error = "capacity violated on the edge from " + vertex_name(vertex)
+                            + " to " + vertex_name(edge->head);
+                    }
+                    // flow on the edge, the reverse edge carries the same flow negated
+                    net_outflow += Sum{edge->back_up_capacity} - edge->capacity;
+                }
+                if(graph.is_sink(vertex)) {
+                    result.sink_inflow -= net_outflow;
+                } else if(!graph.is_source(vertex) && result.error.empty()
+                        && (net_outflow > 0 || (kind == FlowKind::flow && net_outflow != 0))) {
+                    result.error = "flow not conserved at vertex " + vertex_name(vertex);
+                }
+            }
+        });
+        Sum flow{0};
+        for(auto& result : partial) {
+            flow += result.sink_inflow;
+            if(certificate.error.empty()) { certificate.error = result.error; }
+        }
+        certificate.flow = saturated(flow);
+        if(!certificate.error.empty()) { return certificate; }
+        if(flow != max_flow) {
+            certificate.error = "the flow into the sinks is " + sum_name(flow) + ", not the value returned";
+            return certificate;
+        }
+
+        // maximality: a cut of the same capacity
+        auto side{residual_source_side(graph, kind)};
+        bool separated{std::ranges::all_of(graph.sources(), [&side](I v) { return side[v] == 1; })
+            && std::ranges::all_of(graph.sinks(), [&side](I v) { return side[v] == 0; })};
+        if(!separated) {
+            certificate.error = "a sink is reachable in the residual network, the flow is not maximum";
+            return certificate;
+        }
+        utils::parallel_for(0, graph.m_n, threads, [&](unsigned id, std::size_t begin, std::size_t end) {
+            auto& result{partial[id]};
+            for(std::size_t v{begin}; v < end; ++v) {
+                if(!side[v]) { continue; }
+                for(auto* edge : graph.m_adj_list[v]) {
+                    if(!side[edge->head]) { result.cut += edge->back_up_capacity; }
+                }
+            }
+        });
+        Sum cut{0};
+        for(auto& result : partial) {
+            cut += result.cut;
+        }
+        certificate.cut_capacity = saturated(cut);
+        if(cut != flow) {
+            certificate.error = "the cut has capacity " + sum_name(cut) + ", not the flow";
+            return certificate;
+        }
+        certificate.valid = true;
+        return certificate;
+    }
+}
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include "../data structures/graph.h"
+#include "../data structures/linkcuttree.h"
+
+#include <vector>
+#include <utility>
+
+/**
+ * Buffers used by the algorithms. A workspace is sized once for the largest
+ * graph it was used on and can be reused for any number of solves, so
+ * repeated solves don't allocate. "Cleared" marks use epochs instead of
+ * writing all n entries.
+ */
+namespace algorithms {
+
+    /**
+     * @brief Visited marks that are cleared in O(1) by starting a new epoch.
+     * 
+     * @tparam I Index type.
+     */
+    template <typename I>
+    class VisitedMarks {
+
+        public:
+            /**
+             * @brief Makes room for n vertices, all unvisited.
+             */
+            void resize(I n);
+
+            /**
+             * @brief Marks every vertex as unvisited. (O(n) only once every 2^32 clears)
+             */
+            void clear();
+
+            bool visited(I vertex) const { return m_stamps[vertex] == m_epoch; }
+            void visit(I vertex) { m_stamps[vertex] = m_epoch; }
+
+            /**
+             * @brief A vertex is visited iff its stamp equals the epoch (for the scan kernels).
+             */
+            const unsigned int* stamps() const { return m_stamps.data(); }
+            unsigned int epoch() const { return m_epoch; }
+
+        private:
+            std::vector<unsigned int> m_stamps{};
+            unsigned int m_epoch{1};
+    };
+
+    /**
+     * @brief First-in first-out queue on a fixed ring buffer.
+     * 
+     * @tparam V Element type.
+     */
+    template <typename V>
+    class RingQueue {
+
+        public:
+            /**
+             * @brief Empties the queue and makes room for at least capacity elements.
+             */
+            void reset(std::size_t capacity);
+
+            bool empty() const { return m_size == 0; }
+            const V& front() const { return m_data[m_front]; }
+            void pop();
+            void push(V value);
+
+        private:
+            std::vector<V> m_data{};
+            std::size_t m_front{0};
+            std::size_t m_size{0};
+    };
+
+    /**
+     * @brief First-in first-out queues of vertices indexed by label. Every vertex is
+     *        in at most one bucket, the queues are linked lists through the vertices.
+     * 
+     * @tparam I Index type.
+     */
+    template <typename I>
+    class Buckets {
+
+        public:
+            /**
+             * @brief Empties all buckets, makes room for num_buckets buckets and n vertices.
+             */
+            void reset(I num_buckets, I n);
+
+            bool empty(I bucket) const { return m_front[bucket] == -1; }
+            I front(I bucket) const { return m_front[bucket]; }
+            void pop(I bucket);
+            void push(I bucket, I vertex);
+
+        private:
+            std::vector<I> m_front{};
+            std::vector<I> m_back{};
+            std::vector<I> m_next{};
+    };
+
+    /**
+     * @brief Buffers of ford-fulkerson and edmonds-karp.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     */
+    template <typename T, typename I>
+    struct FordFulkersonWorkspace {
+        /**
+         * @brief m_augmenting_path[v] = edge used to reach v, only valid if v is visited.
+         */
+        std::vector<typename ds::Graph<T, I>::Edge*> m_augmenting_path{};
+        VisitedMarks<I> m_visited{};
+
+        /**
+         * @brief (vertex, flow pushed so far) pairs, used as stack (dfs) or queue (bfs).
+         */
+        std::vector<std::pair<I, T>> m_to_visit{};
+
+        /**
+         * @brief Marks and queue of the half of a bidirectional bfs grown from the sinks.
+         *        m_next_edge[v] = edge from v toward a sink, only valid if v is marked.
+         */
+        VisitedMarks<I> m_visited_backward{};
+        std::vector<typename ds::Graph<T, I>::Edge*> m_next_edge{};
+        std::vector<I> m_backward{};
+
+        /**
+         * @brief The sink reached by the last search (the end of the augmenting path).
+         */
+        I m_sink{};
+
+        /**
+         * @brief Sizes the buffers for the graph (only grows) and clears the marks.
+         */
+        void prepare(const ds::Graph<T, I>& graph);
+    };
+
+    /**
+     * @brief Buffers of dinic's algorithm.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     */
+    template <typename T, typename I>
+    struct DinicWorkspace {
+        /**
+         * @brief Level of each vertex in the current level graph, only valid if reached.
+         */
+        std::vector<I> m_level{};
+        VisitedMarks<I> m_reached{};
+
+        /**
+         * @brief The next edge the dfs considers per vertex, only valid if reached.
+         */
+        std::vector<I> m_edges_to_visit{};
+        std::vector<I> m_queue{};
+
+        /**
+         * @brief Edge indices found by the bfs scan kernel, grows to the largest degree scanned.
+         */
+        std::vector<I> m_candidates{};
+
+        /**
+         * @brief Level of a vertex, -1 if not reached by the last bfs.
+         */
+        I level(I vertex) const { return m_reached.visited(vertex) ? m_level[vertex] : -1; }
+
+        /**
+         * @brief Sizes the buffers for the graph (only grows) and clears the marks.
+         */
+        void prepare(const ds::Graph<T, I>& graph);
+    };
+
+    /**
+     * @brief Buffers of dinic's algorithm with dynamic trees.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     */
+    template <typename T, typename I>
+    struct DynamicTreeDinicWorkspace {
+        /**
+         * @brief Level graph and current edge of each vertex.
+         */
+        DinicWorkspace<T, I> m_levels{};
+
+        /**
+         * @brief Forest of current edges, the value of a vertex is the residual capacity
+         *        of its current edge (not written to the edge until it is cut).
+         */
+        ds::LinkCutTree<T, I> m_tree{};
+
+        /**
+         * @brief m_tree_edge[v] = edge from v to its parent in the forest, nullptr for roots.
+         */
+        std::vector<typename ds::Graph<T, I>::Edge*> m_tree_edge{};
+
+        /**
+         * @brief Vertices linked during the current phase.
+         */
+        std::vector<I> m_linked{};
+
+        /**
+         * @brief Vertices without a path to a sink in the current level graph.
+         */
+        VisitedMarks<I> m_dead{};
+
+        /**
+         * @brief Sizes the buffers for the graph (only grows) and makes every vertex a root.
+         */
+        void prepare(const ds::Graph<T, I>& graph);
+    };
+
+    /**
+     * @brief Buffers of both push-relabel algorithms.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type.
+     */
+    template <typename T, typename I>
+    struct PushRelabelWorkspace {
+        std::vector<I> m_labels{};
+        std::vector<I> m_current_edges{};
+        std::vector<T> m_excess{};
+
+        /**
+         * @brief Active vertices of the generic push-relabel.
+         */
+        RingQueue<I> m_active{};
+
+        /**
+         * @brief Active vertices by label and gap counts of the highest label variant.
+         */
+        Buckets<I> m_buckets{};
+        std::vector<I> m_gap{};
+
+        /**
+         * @brief Sizes the buffers for the graph (only grows) and resets labels, 
+         *        current edges and excess to their initial values.
+         */
+        void prepare(const ds::Graph<T, I>& graph);
+    };
+}
+
+#include "workspace.ipp"
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef WORKSPACE_IPP
+#define WORKSPACE_IPP
+
+#include "../data structures/graph.h"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace algorithms {
+
+    /**
+     * @brief Makes room for n values and sets the first n to value. Reused for 
+     *        smaller graphs, the entries past n are left alone.
+     */
+    template <typename V>
+    void reset_prefix(std::vector<V>& values, std::size_t n, V value) {
+        if(n > values.size()) {
+            values.resize(n);
+        }
+        std::fill_n(values.begin(), n, value);
+    }
+
+    /**
+     * @brief Makes room for n vertices, all unvisited.
+     */
+    template <typename I>
+    void VisitedMarks<I>::resize(I n) {
+        if(static_cast<std::size_t>(n) > m_stamps.size()) {
+            // new entries hold epoch 0, never a current epoch
+            m_stamps.resize(n, 0);
+        }
+    }
+
+    /**
+     * @brief Marks every vertex as unvisited. (O(n) only once every 2^32 clears)
+     */
+    template <typename I>
+    void VisitedMarks<I>::clear() {
+        if(++m_epoch == 0) {
+            std::fill(m_stamps.begin(), m_stamps.end(), 0);
+            m_epoch = 1;
+        }
+    }
+
+    /**
+     * @brief Empties the queue and makes room for at least capacity elements.
+     */
+    template <typename V>
+    void RingQueue<V>::reset(std::size_t capacity) {
+        if(capacity > m_data.size()) {
+            m_data.resize(capacity);
+        }
+        m_front = 0;
+        m_size = 0;
+    }
+
+    template <typename V>
+    void RingQueue<V>::pop() {
+        m_front = (m_front+1 == m_data.size()) ? 0 : m_front+1;
+        --m_size;
+    }
+
+    template <typename V>
+    void RingQueue<V>::push(V value) {
+        std::size_t back{m_front + m_size};
+        m_data[back >= m_data.size() ? back - m_data.size() : back] = value;
+        ++m_size;
+    }
+
+    /**
+     * @brief Empties all buckets, makes room for num_buckets buckets and n vertices.
+     */
+    template <typename I>
+    void Buckets<I>::reset(I num_buckets, I n) {
+        reset_prefix(m_front, num_buckets, I{-1});
+        m_back.resize(m_front.size());
+        if(static_cast<std::size_t>(n) > m_next.size()) {
+            m_next.resize(n);
+        }
+    }
+
+    template <typename I>
+    void Buckets<I>::pop(I bucket) {
+        m_front[bucket] = m_next[m_front[bucket]];
+    }
+
+    template <typename I>
+    void Buckets<I>::push(I bucket, I vertex) {
+        m_next[vertex] = -1;
+        if(empty(bucket)) {
+            m_front[bucket] = vertex;
+        } else {
+            m_next[m_back[bucket]] = vertex;
+        }
+        m_back[bucket] = vertex;
+    }
+
+    /**
+     * @brief Sizes the buffers for the graph (only grows) and clears the marks.
+     */
+    template <typename T, typename I>
+    void FordFulkersonWorkspace<T, I>::prepare(const ds::Graph<T, I>& graph) {
+        if(static_cast<std::size_t>(graph.m_n) > m_augmenting_path.size()) {
+            m_augmenting_path.resize(graph.m_n, nullptr);
+            m_to_visit.reserve(graph.m_n);
+            m_next_edge.resize(graph.m_n, nullptr);
+            m_backward.reserve(graph.m_n);
+        }
+        m_visited.resize(graph.m_n);
+        m_visited.clear();
+        m_visited_backward.resize(graph.m_n);
+    }
+
+    /**
+     * @brief Sizes the buffers for the graph (only grows) and clears the marks.
+     */
+    template <typename T, typename I>
+    void DinicWorkspace<T, I>::prepare(const ds::Graph<T, I>& graph) {
+        if(static_cast<std::size_t>(graph.m_n) > m_level.size()) {
+            m_level.resize(graph.m_n);
+            m_edges_to_visit.resize(graph.m_n);
+            m_queue.resize(graph.m_n);
+        }
+        m_reached.resize(graph.m_n);
+        m_reached.clear();
+    }
+
+    /**
+     * @brief Sizes the buffers for the graph (only grows) and makes every vertex a root.
+     */
+    template <typename T, typename I>
+    void DynamicTreeDinicWorkspace<T, I>::prepare(const ds::Graph<T, I>& graph) {
+        m_levels.prepare(graph);
+        m_tree.reset(graph.m_n);
+        if(static_cast<std::size_t>(graph.m_n) > m_tree_edge.size()) {
+            m_tree_edge.resize(graph.m_n);
+        }
+        std::fill(m_tree_edge.begin(), m_tree_edge.begin()+graph.m_n, nullptr);
+        m_linked.clear();
+        m_dead.resize(graph.m_n);
+        m_dead.clear();
+    }
+
+    /**
+     * @brief Sizes the buffers for the graph (only grows) and resets labels, 
+     *        current edges and excess to their initial values.
+     */
+    template <typename T, typename I>
+    void PushRelabelWorkspace<T, I>::prepare(const ds::Graph<T, I>& graph) {
+        // labels (or heights), all 0 except for the sources at n (#vertices in the graph)
+        reset_prefix(m_labels, graph.m_n, I{0});
+        for(I source : graph.sources()) {
+            m_labels[source] = graph.m_n;
+        }
+        reset_prefix(m_current_edges, graph.m_n, I{0});
+        // excess function, the preflow makes it negative at the sources
+        reset_prefix(m_excess, graph.m_n, T{0});
+        // every vertex is at most once in the queue
+        m_active.reset(graph.m_n);
+    }
+}
+
+#endif
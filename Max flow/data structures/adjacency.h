@@ -0,0 +1,78 @@
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+
+#include "arcstorage.h"
+
+#include <cstddef>
+#include <span>
+
+namespace ds {
+
+    /**
+     * @brief The adjacency lists of a graph, stored like its edges (RAM or memory-mapped
+     *        files, see StorageOptions). All lists share one array of slots, a list that
+     *        outgrows its slots moves to the end of the array (reserve avoids that when the
+     *        degrees are known, e.g. when loading a file).
+     * 
+     *        lists[v] is a span over the list of v. It stays valid until a list is grown.
+     * 
+     * @tparam E Element type (Edge*).
+     * @tparam I Index type of vertices.
+     */
+    template <typename E, typename I>
+    class AdjacencyLists {
+
+        public:
+            AdjacencyLists(I n, StorageOptions options = {});
+
+            std::span<E> operator[](I vertex) {
+                const Range& range{m_ranges[vertex]};
+                return {m_slots.data() + range.offset, static_cast<std::size_t>(range.size)};
+            }
+
+            std::span<const E> operator[](I vertex) const {
+                const Range& range{m_ranges[vertex]};
+                return {m_slots.data() + range.offset, static_cast<std::size_t>(range.size)};
+            }
+
+            /**
+             * @brief Number of lists (vertices).
+             */
+            std::size_t size() const { return m_ranges.size(); }
+
+            /**
+             * @brief Adds an empty list.
+             */
+            void add_vertex();
+
+            /**
+             * @brief Appends to the list of the vertex, moves it if it is full.
+             */
+            void push_back(I vertex, E element);
+
+            /**
+             * @brief Makes room for count elements in the list of the vertex, so that
+             *        appending up to count elements does not move it (or any other list).
+             */
+            void reserve(I vertex, std::size_t count);
+
+        private:
+            struct Range {
+                std::size_t offset;
+                I size;
+                I capacity;
+            };
+
+            /**
+             * @brief Moves the list of the vertex to the end of the slots, with the given capacity.
+             */
+            void move_to_end(I vertex, std::size_t capacity);
+
+            FlatStorage<Range> m_ranges;
+            FlatStorage<E> m_slots;
+    };
+}
+
+#include "adjacency.ipp"
+
+#endif
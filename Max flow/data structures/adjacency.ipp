@@ -0,0 +1,71 @@
+#ifndef ADJACENCY_IPP
+#define ADJACENCY_IPP
+
+#include <algorithm>
+#include <cstring>
+
+namespace ds {
+
+    template <typename E, typename I>
+    AdjacencyLists<E, I>::AdjacencyLists(I n, StorageOptions options)
+        : m_ranges{options}
+        , m_slots{std::move(options)} {
+        m_ranges.resize(n);
+        std::fill_n(m_ranges.data(), n, Range{0, 0, 0});
+    }
+
+    /**
+     * @brief Adds an empty list.
+     */
+    template <typename E, typename I>
+    void AdjacencyLists<E, I>::add_vertex() {
+        m_ranges.resize(m_ranges.size()+1);
+        m_ranges[m_ranges.size()-1] = Range{0, 0, 0};
+    }
+
+    template <typename E, typename I>
+    void AdjacencyLists<E, I>::move_to_end(I vertex, std::size_t capacity) {
+        Range& range{m_ranges[vertex]};
+        std::size_t end{range.offset + static_cast<std::size_t>(range.capacity)};
+        if(range.capacity > 0 && end == m_slots.size()) {
+            // the last list grows in place
+            m_slots.resize(range.offset + capacity);
+            range.capacity = static_cast<I>(capacity);
+            return;
+        }
+        std::size_t offset{m_slots.size()};
+        m_slots.resize(offset + capacity);
+        // the old slots are left unused
+        if(range.size > 0) {
+            std::memcpy(m_slots.data() + offset, m_slots.data() + range.offset, range.size*sizeof(E));
+        }
+        range.offset = offset;
+        range.capacity = static_cast<I>(capacity);
+    }
+
+    /**
+     * @brief Appends to the list of the vertex, moves it if it is full.
+     */
+    template <typename E, typename I>
+    void AdjacencyLists<E, I>::push_back(I vertex, E element) {
+        if(m_ranges[vertex].size == m_ranges[vertex].capacity) {
+            move_to_end(vertex, std::max<std::size_t>(4, 2*static_cast<std::size_t>(m_ranges[vertex].capacity)));
+        }
+        Range& range{m_ranges[vertex]};
+        m_slots[range.offset + range.size] = element;
+        ++range.size;
+    }
+
+    /**
+     * @brief Makes room for count elements in the list of the vertex, so that
+     *        appending up to count elements does not move it (or any other list).
+     */
+    template <typename E, typename I>
+    void AdjacencyLists<E, I>::reserve(I vertex, std::size_t count) {
+        if(count > static_cast<std::size_t>(m_ranges[vertex].capacity)) {
+            move_to_end(vertex, count);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef ARC_STORAGE_H
+#define ARC_STORAGE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ds {
+
+    /**
+     * @brief Where the edges of a graph are kept.
+     */
+    struct StorageOptions {
+        /**
+         * @brief Directory for the (unlinked) files backing the edges and the adjacency
+         *        lists. If empty, both are kept in RAM. With a directory, graphs larger
+         *        than RAM are paged in and out of the files by the OS.
+         */
+        std::string backing_directory{};
+
+        /**
+         * @brief Ask the OS for transparent huge pages (madvise) for the edges.
+         *        Only applies to anonymous mappings (no backing directory), pages of
+         *        file-backed mappings are huge only on a tmpfs mounted with huge=.
+         *        Ignored where not supported.
+         */
+        bool huge_pages{false};
+    };
+
+    /**
+     * @brief Chunked storage for the edges of a graph. Chunks never move, so 
+     *        pointers to elements stay valid while the storage grows. Chunks are 
+     *        either allocated on the heap or memory-mapped.
+     * 
+     * @tparam E Element type, needs to be trivially destructible.
+     */
+    template <typename E>
+    class ArcStorage {
+
+        public:
+            ArcStorage(StorageOptions options = {});
+            ArcStorage(ArcStorage&& other);
+            ArcStorage(const ArcStorage&) = delete;
+            ArcStorage& operator=(const ArcStorage&) = delete;
+            ~ArcStorage();
+
+            /**
+             * @brief Makes room for count more elements. The new elements are not constructed.
+             * 
+             * @param count Number of elements to add.
+             * @return std::size_t Index of the first new element.
+             */
+            std::size_t grow(std::size_t count);
+
+            /**
+             * @brief Pointer to the element at the given index.
+             */
+            E* at(std::size_t index) { return m_chunks[index / m_per_chunk] + index % m_per_chunk; }
+
+            /**
+             * @brief Number of elements.
+             */
+            std::size_t size() const { return m_size; }
+
+            /**
+             * @brief Calls f on every element, chunk by chunk.
+             */
+            void for_each(auto&& f);
+
+            const StorageOptions& options() const { return m_options; }
+
+        private:
+            E* allocate_chunk();
+            // chunks are memory-mapped instead of allocated on the heap
+            bool mapped() const { return !m_options.backing_directory.empty() || m_options.huge_pages; }
+
+            StorageOptions m_options{};
+            // elements per chunk
+            std::size_t m_per_chunk{};
+            std::size_t m_size{0};
+            std::vector<E*> m_chunks{};
+    };
+
+    /**
+     * @brief Contiguous growable array, on the heap or memory-mapped like ArcStorage
+     *        (a single mapping, grown with mremap). Growing may move the elements,
+     *        so only indices stay valid.
+     * 
+     * @tparam E Element type, needs to be trivially copyable.
+     */
+    template <typename E>
+    class FlatStorage {
+
+        public:
+            FlatStorage(StorageOptions options = {});
+            FlatStorage(FlatStorage&& other);
+            FlatStorage& operator=(FlatStorage&& other);
+            FlatStorage(const FlatStorage&) = delete;
+            FlatStorage& operator=(const FlatStorage&) = delete;
+            ~FlatStorage();
+
+            /**
+             * @brief Changes the number of elements, new elements are not initialized.
+             *        The capacity grows geometrically.
+             */
+            void resize(std::size_t size);
+
+            E* data() { return m_data; }
+            const E* data() const { return m_data; }
+            E& operator[](std::size_t index) { return m_data[index]; }
+            const E& operator[](std::size_t index) const { return m_data[index]; }
+            std::size_t size() const { return m_size; }
+            const StorageOptions& options() const { return m_options; }
+
+        private:
+            bool mapped() const { return !m_options.backing_directory.empty() || m_options.huge_pages; }
+            void release();
+
+            StorageOptions m_options{};
+            E* m_data{nullptr};
+            std::size_t m_size{0};
+            std::size_t m_capacity{0};
+            // backing file of a mapping, -1 if anonymous or on the heap
+            int m_fd{-1};
+    };
+}
+
+#include "arcstorage.ipp"
+
+#endif
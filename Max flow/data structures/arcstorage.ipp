@@ -0,0 +1,208 @@
+#ifndef ARC_STORAGE_IPP
+#define ARC_STORAGE_IPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ds {
+
+    // heap chunks stay small for small graphs, mapped chunks are a multiple of 2 MiB (huge page size)
+    constexpr std::size_t heap_chunk_bytes{1 << 19};
+    constexpr std::size_t mapped_chunk_bytes{1 << 26};
+
+    template <typename E>
+    ArcStorage<E>::ArcStorage(StorageOptions options)
+        : m_options{std::move(options)} {
+        static_assert(std::is_trivially_destructible_v<E>, "elements are never destroyed");
+        m_per_chunk = std::max<std::size_t>((mapped() ? mapped_chunk_bytes : heap_chunk_bytes) / sizeof(E), 1);
+    }
+
+    template <typename E>
+    ArcStorage<E>::ArcStorage(ArcStorage&& other)
+        : m_options{std::move(other.m_options)}
+        , m_per_chunk{other.m_per_chunk}
+        , m_size{other.m_size}
+        , m_chunks{std::move(other.m_chunks)} {
+        other.m_chunks.clear();
+        other.m_size = 0;
+    }
+
+    template <typename E>
+    ArcStorage<E>::~ArcStorage() {
+        for(E* chunk : m_chunks) {
+            if(mapped()) {
+                munmap(chunk, m_per_chunk*sizeof(E));
+            } else {
+                std::free(chunk);
+            }
+        }
+    }
+
+    /**
+     * @brief Allocates a new chunk, on the heap, anonymously mapped (huge pages) 
+     *        or mapped to an unlinked file in the backing directory.
+     */
+    template <typename E>
+    E* ArcStorage<E>::allocate_chunk() {
+        std::size_t bytes{m_per_chunk*sizeof(E)};
+        if(!mapped()) {
+            void* chunk{std::malloc(bytes)};
+            if(!chunk) { throw std::bad_alloc{}; }
+            return static_cast<E*>(chunk);
+        }
+        void* chunk{MAP_FAILED};
+        if(m_options.backing_directory.empty()) {
+            chunk = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        } else {
+            std::string path{m_options.backing_directory + "/arcs-XXXXXX"};
+            int fd{mkstemp(path.data())};
+            if(fd == -1) {
+                std::cout << "Error creating backing file in " << m_options.backing_directory << ".\n";
+                throw std::bad_alloc{};
+            }
+            // the mapping keeps the file alive
+            unlink(path.c_str());
+            if(ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+                chunk = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            close(fd);
+        }
+        if(chunk == MAP_FAILED) { throw std::bad_alloc{}; }
+#ifdef MADV_HUGEPAGE
+        // no effect on file-backed mappings (except on tmpfs)
+        if(m_options.huge_pages && m_options.backing_directory.empty()) {
+            madvise(chunk, bytes, MADV_HUGEPAGE);
+        }
+#endif
+        return static_cast<E*>(chunk);
+    }
+
+    /**
+     * @brief Makes room for count more elements. The new elements are not constructed.
+     * 
+     * @param count Number of elements to add.
+     * @return std::size_t Index of the first new element.
+     */
+    template <typename E>
+    std::size_t ArcStorage<E>::grow(std::size_t count) {
+        std::size_t first{m_size};
+        m_size += count;
+        while(m_chunks.size()*m_per_chunk < m_size) {
+            m_chunks.push_back(allocate_chunk());
+        }
+        return first;
+    }
+
+    /**
+     * @brief Calls f on every element, chunk by chunk.
+     */
+    template <typename E>
+    void ArcStorage<E>::for_each(auto&& f) {
+        for(std::size_t c{0}; c < m_chunks.size(); ++c) {
+            std::size_t end{std::min(m_per_chunk, m_size - c*m_per_chunk)};
+            for(std::size_t i{0}; i < end; ++i) {
+                f(m_chunks[c][i]);
+            }
+        }
+    }
+
+    template <typename E>
+    FlatStorage<E>::FlatStorage(StorageOptions options)
+        : m_options{std::move(options)} {
+        static_assert(std::is_trivially_copyable_v<E>, "elements are moved with realloc/mremap");
+    }
+
+    template <typename E>
+    FlatStorage<E>::FlatStorage(FlatStorage&& other)
+        : m_options{std::move(other.m_options)}
+        , m_data{std::exchange(other.m_data, nullptr)}
+        , m_size{std::exchange(other.m_size, 0)}
+        , m_capacity{std::exchange(other.m_capacity, 0)}
+        , m_fd{std::exchange(other.m_fd, -1)} {}
+
+    template <typename E>
+    FlatStorage<E>& FlatStorage<E>::operator=(FlatStorage&& other) {
+        if(this != &other) {
+            release();
+            m_options = std::move(other.m_options);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_fd = std::exchange(other.m_fd, -1);
+        }
+        return *this;
+    }
+
+    template <typename E>
+    FlatStorage<E>::~FlatStorage() {
+        release();
+    }
+
+    template <typename E>
+    void FlatStorage<E>::release() {
+        if(m_data) {
+            if(mapped()) {
+                munmap(m_data, m_capacity*sizeof(E));
+            } else {
+                std::free(m_data);
+            }
+        }
+        if(m_fd != -1) { close(m_fd); }
+        m_data = nullptr;
+        m_size = m_capacity = 0;
+        m_fd = -1;
+    }
+
+    /**
+     * @brief Changes the number of elements, new elements are not initialized.
+     *        The capacity grows geometrically.
+     */
+    template <typename E>
+    void FlatStorage<E>::resize(std::size_t size) {
+        if(size > m_capacity) {
+            std::size_t capacity{std::max({size, 2*m_capacity, mapped() ? mapped_chunk_bytes/sizeof(E) : 64})};
+            std::size_t bytes{capacity*sizeof(E)};
+            void* data{nullptr};
+            if(!mapped()) {
+                data = std::realloc(m_data, bytes);
+                if(!data) { throw std::bad_alloc{}; }
+            } else {
+                if(!m_options.backing_directory.empty()) {
+                    if(m_fd == -1) {
+                        std::string path{m_options.backing_directory + "/lists-XXXXXX"};
+                        m_fd = mkstemp(path.data());
+                        if(m_fd == -1) {
+                            std::cout << "Error creating backing file in " << m_options.backing_directory << ".\n";
+                            throw std::bad_alloc{};
+                        }
+                        unlink(path.c_str());
+                    }
+                    if(ftruncate(m_fd, static_cast<off_t>(bytes)) != 0) { throw std::bad_alloc{}; }
+                }
+                int flags{m_fd == -1 ? MAP_PRIVATE | MAP_ANONYMOUS : MAP_SHARED};
+                data = m_data ? mremap(m_data, m_capacity*sizeof(E), bytes, MREMAP_MAYMOVE)
+                    : mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, m_fd, 0);
+                if(data == MAP_FAILED) { throw std::bad_alloc{}; }
+#ifdef MADV_HUGEPAGE
+                if(m_options.huge_pages && m_fd == -1) {
+                    madvise(data, bytes, MADV_HUGEPAGE);
+                }
+#endif
+            }
+            m_data = static_cast<E*>(data);
+            m_capacity = capacity;
+        }
+        m_size = size;
+    }
+}
+
+#endif
@@ -1,8 +1,15 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include "arcstorage.h"
+#include "adjacency.h"
+
 #include <vector>
 #include <string>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
 
 namespace ds {
 
@@ -10,8 +17,10 @@ namespace ds {
      * @brief Class representing a residual network.
      * 
      * @tparam T Flow type.
+     * @tparam I Index type of vertices (and edges within an adjacency list). 
+     *           int as long as the graph fits, long long for huge graphs (see fits_index).
      */
-    template <typename T>
+    template <typename T, typename I = int>
     class Graph {
 
         public:
@@ -22,66 +31,215 @@ namespace ds {
             *        Stores the capacity and a pointer to the "reverse" edge in the residual network.
             */
             struct Edge {
-                int tail{-1};
-                int head{-1};
+                I tail{-1};
+                I head{-1};
                 T capacity{-1};
-                // reverse edge in the residual graph
-                Edge* reverse{nullptr};
                 // to restore the edge
                 T back_up_capacity{-1};
+                // reverse edge in the residual graph
+                Edge* reverse{nullptr};
 
                 // Edge constructor
-                Edge(int t, int h, T c);
+                Edge(I t, I h, T c);
 
                 void restore() {capacity = back_up_capacity;}
             };
 
             /**
-             * @brief The adjacency list.
+             * @brief An arc of the input network, as read from a file or built by a generator.
+             */
+            struct Arc {
+                I tail{-1};
+                I head{-1};
+                T capacity{0};
+                // capacity in both directions, stored as a single residual pair
+                bool undirected{false};
+            };
+
+            /**
+             * @brief The adjacency list, kept where the edges are (see StorageOptions).
              *        m_adj_list[v] = all outgoing edges from v
              */
-            std::vector<std::vector<Edge*>> m_adj_list{};
+            AdjacencyLists<Edge*, I> m_adj_list;
             
             /**
-             * @brief Number of vertices in the graph.
+             * @brief Number of vertices in the graph. (Including the vertices
+             *        added internally for vertex capacities)
              */
-            int m_n{};
+            I m_n{};
 
             /**
-             * @brief Source node. Initialized as 0
+             * @brief Source node. Initialized as 0 (the first source if there are several, see set_sources)
              */
-            int m_s{};
+            I m_s{};
 
             /**
-             * @brief Sink node. Initialized as #vertices-1
+             * @brief Sink node. Initialized as #vertices-1 (the first sink if there are several, see set_sinks)
              */
-            int m_t{};
+            I m_t{};
 
             /**
              * @brief Initializes the adjacency matrix to hold n vertices. Source 
              *        and sink are initialized as 0 and n-1 respectively, while the lists
              *        of edges for each vertex is empty.
+             * 
+             * @param n Number of vertices.
+             * @param options Where to keep the edges (RAM or memory-mapped files).
              */
-            Graph(int n);
+            Graph(I n, StorageOptions options = {});
 
-            // destructor for edges
-            ~Graph();
+            // edges are owned by the graph, moving transfers them
+            Graph(Graph&& other) = default;
+            Graph(const Graph&) = delete;
+            Graph& operator=(const Graph&) = delete;
 
             /**
              * @brief Adds an edge to the current network. The reverse edge
              *        is added automatically.
              * 
              *
-             * @param v_in An Integer, the tail of the edge. 
-             * @param v_out An Integer, the head of the edge.
+             * @param v_in The tail of the edge. 
+             * @param v_out The head of the edge.
              * @param capacity Total capacity of the edge.
              */
-            void add_edge(int v_in, int v_out, T capacity);
+            void add_edge(I v_in, I v_out, T capacity);
+
+            /**
+             * @brief Adds all arcs to the network using multiple threads. The resulting
+             *        adjacency lists are identical to calling add_edge for each arc in order.
+             * 
+             * @param arcs The arcs to add.
+             * @param num_threads Number of threads to use (0 = all hardware threads).
+             */
+            void add_edges(const std::vector<Arc>& arcs, unsigned num_threads=0);
+
+            /**
+             * @brief Makes room for count edges in the list of the vertex (a hint, e.g. from
+             *        the degrees counted while loading), so the lists are built in place.
+             * 
+             * @param vertex The vertex.
+             * @param count Number of edges (including reverse edges) its list will hold.
+             */
+            void reserve_edges(I vertex, std::size_t count) { m_adj_list.reserve(vertex, count); }
+
+            /**
+             * @brief Number of edges, reverse edges included.
+             */
+            std::size_t num_edges() const { return m_edges.size(); }
+
+            /**
+             * @brief Adds an undirected edge with the given capacity in both directions.
+             *        Stored as a single pair of edges, where each one is the reverse of 
+             *        the other, instead of two edges and two reverse edges.
+             * 
+             * @param u One end of the edge.
+             * @param v The other end of the edge.
+             * @param capacity Capacity in each direction.
+             */
+            void add_undirected_edge(I u, I v, T capacity);
+
+            /**
+             * @brief Limits the flow through a vertex. Has to be called before edges 
+             *        incident to the vertex are added (can be called again to change
+             *        the capacity).
+             * 
+             *        The vertex is split internally: its id keeps the incoming edges and
+             *        a new vertex (see out) the outgoing ones, connected by an edge with 
+             *        the given capacity. The solvers need no special handling, and ids of
+             *        the original vertices do not change.
+             * 
+             *        Throws std::invalid_argument for a sink (m_t included, so set the sinks
+             *        first): the flow into a sink never reaches the second half. Limit the
+             *        edges into the sink instead.
+             * 
+             * @param vertex The vertex.
+             * @param capacity Maximum flow through the vertex.
+             */
+            void set_vertex_capacity(I vertex, T capacity);
+
+            /**
+             * @brief Makes all given vertices sources, so no super source with an edge to each
+             *        of them is needed. Replaces m_s by the first one (a single vertex is the
+             *        same as setting m_s). Throws std::invalid_argument if one of them is a sink
+             *        (m_t included, so set m_t first if a source would collide with its default).
+             * 
+             * @param sources The sources, at least one.
+             */
+            void set_sources(const std::vector<I>& sources);
+
+            /**
+             * @brief Makes all given vertices sinks, same as set_sources (throws if one of them
+             *        is a source or has a vertex capacity).
+             * 
+             * @param sinks The sinks, at least one.
+             */
+            void set_sinks(const std::vector<I>& sinks);
+
+            /**
+             * @brief All sources (only m_s unless set_sources was given several).
+             */
+            std::span<const I> sources() const { 
+                return m_sources.empty() ? std::span<const I>{&m_s, 1} : std::span<const I>{m_sources}; 
+            }
+
+            /**
+             * @brief All sinks (only m_t unless set_sinks was given several).
+             */
+            std::span<const I> sinks() const { 
+                return m_sinks.empty() ? std::span<const I>{&m_t, 1} : std::span<const I>{m_sinks}; 
+            }
+
+            bool is_source(I vertex) const { 
+                return m_sources.empty() ? vertex == m_s : (m_terminal[vertex] & source_flag) != 0; 
+            }
+
+            bool is_sink(I vertex) const { 
+                return m_sinks.empty() ? vertex == m_t : (m_terminal[vertex] & sink_flag) != 0; 
+            }
+
+            /**
+             * @brief The vertex carrying the outgoing edges of the given vertex,
+             *        different from vertex only if it has a vertex capacity.
+             */
+            I out(I vertex) const { 
+                return vertex < static_cast<I>(m_out.size()) ? m_out[vertex] : vertex; 
+            }
 
             /**
              * @brief Shuffles the adjacency list.
+             * 
+             * @return unsigned int The seed used, shuffle_edges(seed) repeats the shuffle.
+             */
+            unsigned int shuffle_edges();
+
+            /**
+             * @brief Shuffles the adjacency list reproducibly.
+             * 
+             * @param seed Seed of the random engine.
+             */
+            void shuffle_edges(unsigned int seed);
+
+            /**
+             * @brief Relabels the vertices and sorts every adjacency list by head, 
+             *        see ds::reorder for orders that keep neighbours close in memory.
+             * 
+             * @param order order[k] = the vertex that gets id k. (A permutation of all vertices)
+             */
+            void relabel(const std::vector<I>& order);
+
+            /**
+             * @brief The id a vertex had before any relabeling.
+             */
+            I original_id(I vertex) const {
+                return m_original_id.empty() ? vertex : m_original_id[vertex];
+            }
+
+            /**
+             * @brief The current id of a vertex given its id before any relabeling.
              */
-            void shuffle_edges();
+            I current_id(I original) const {
+                return m_current_id.empty() ? original : m_current_id[original];
+            }
             
             /**
              * @brief Restore each edge capacity.
@@ -90,9 +248,68 @@ namespace ds {
 
             // for debugging purposes
             void print_graph();
+
+        private:
+            /**
+             * @brief All edges, an edge and its reverse edge are stored next to each other.
+             */
+            ArcStorage<Edge> m_edges;
+
+            /**
+             * @brief m_out[v] = vertex with the outgoing edges of v (empty without vertex capacities).
+             */
+            std::vector<I> m_out{};
+
+            /**
+             * @brief m_inner[v] = the edge from v to out(v), nullptr if v is not split
+             *        (empty without vertex capacities). Stays valid after shuffle and relabel.
+             */
+            std::vector<Edge*> m_inner{};
+
+            /**
+             * @brief Several sources or sinks (both empty for a single source and sink).
+             */
+            std::vector<I> m_sources{};
+            std::vector<I> m_sinks{};
+
+            /**
+             * @brief m_terminal[v] = source_flag and/or sink_flag (empty for a single source and sink).
+             */
+            std::vector<unsigned char> m_terminal{};
+            static constexpr unsigned char source_flag{1};
+            static constexpr unsigned char sink_flag{2};
+
+            /**
+             * @brief Stores the given terminals, marked with flag, in terminals and sets single to the first one.
+             */
+            void set_terminals(const std::vector<I>& given, std::vector<I>& terminals, I& single, unsigned char flag);
+
+            /**
+             * @brief Maps between current ids and ids before relabeling (empty if never relabeled).
+             */
+            std::vector<I> m_original_id{};
+            std::vector<I> m_current_id{};
     };
+
+    /**
+     * @brief Whether a graph with n vertices and m arcs can use the index type I.
+     *        (Every arc adds two edges to the adjacency lists.)
+     */
+    template <typename I>
+    constexpr bool fits_index(long long n, long long m) {
+        return n <= static_cast<long long>(std::numeric_limits<I>::max()) 
+            && 2*m <= static_cast<long long>(std::numeric_limits<I>::max());
+    }
+
+    /**
+     * @brief Type for sums of capacities (cuts, flow into the sinks), which can exceed T.
+     *        long long for smaller flow types, 128 bits for 64 bit ones.
+     */
+    template <typename T>
+    using CapacitySum = std::conditional_t<(sizeof(T) < sizeof(long long)), long long, __int128>;
 }
 
 #include "graph.ipp"
+#include "ordering.h"
 
 #endif
@@ -9,97 +9,402 @@
 #include <cassert>
 #include <random>
 #include <algorithm>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+
+#include "../algorithms/parallel.h"
 
 namespace ds {
 
     // Edge constructor
-    template <typename T>
-    Graph<T>::Edge::Edge(int t, int h, T c)
+    template <typename T, typename I>
+    Graph<T, I>::Edge::Edge(I t, I h, T c)
         : tail{t}
         , head{h}
         , capacity{c} 
-        , reverse{nullptr}
-        , back_up_capacity{c} {}
+        , back_up_capacity{c}
+        , reverse{nullptr} {}
 
     /**
      * @brief Initializes the adjacency matrix to hold n vertices. Source 
      *        and sink are initialized as 0 and n-1 respectively, while the lists
      *        of edges for each vertex is empty.
      */
-    template <typename T>
-    Graph<T>::Graph(int n) 
-        : m_adj_list(n)
+    template <typename T, typename I>
+    Graph<T, I>::Graph(I n, StorageOptions options) 
+        : m_adj_list{n, options}
         , m_n{n}
         , m_s{0}
-        , m_t{n-1} {}
-
-    // Destructor for edges
-    template <typename T>
-    Graph<T>::~Graph() {
-        for(int i{0}; i < m_adj_list.size(); ++i) {
-            for(int j{0}; j < m_adj_list[i].size(); ++j) {
-                delete m_adj_list[i][j];
-            }
-        }
-    }
+        , m_t{n-1}
+        , m_edges{std::move(options)} {}
 
     /**
      * @brief Adds an edge to the current network. The reverse edge
      *        is added automatically.
      * 
      *
-     * @param v_in An Integer, the tail of the edge. 
-     * @param v_out An Integer, the head of the edge.
+     * @param v_in The tail of the edge. 
+     * @param v_out The head of the edge.
      * @param capacity Total capacity of the edge.
      */
-    template <typename T>
-    void Graph<T>::add_edge(int v_in, int v_out, T capacity) {
+    template <typename T, typename I>
+    void Graph<T, I>::add_edge(I v_in, I v_out, T capacity) {
         // no self loops
         if(v_in == v_out) { return; }
+        // outgoing edges of a vertex with a capacity start at its second half
+        v_in = out(v_in);
 
-        Edge* edge = new Edge{v_in, v_out, capacity};
-        Edge* reverse = new Edge{v_out, v_in, 0};
+        std::size_t index{m_edges.grow(2)};
+        Edge* edge = new (m_edges.at(index)) Edge{v_in, v_out, capacity};
+        Edge* reverse = new (m_edges.at(index+1)) Edge{v_out, v_in, 0};
 
         edge->reverse = reverse;
         reverse->reverse = edge;
 
         // add edge + reverse edge
-        m_adj_list[v_in].push_back(edge);
-        m_adj_list[v_out].push_back(reverse);
+        m_adj_list.push_back(v_in, edge);
+        m_adj_list.push_back(v_out, reverse);
+    }
+
+    /**
+     * @brief Adds all arcs to the network using multiple threads. The resulting
+     *        adjacency lists are identical to calling add_edge for each arc in order.
+     * 
+     * @param arcs The arcs to add.
+     * @param num_threads Number of threads to use (0 = all hardware threads).
+     */
+    template <typename T, typename I>
+    void Graph<T, I>::add_edges(const std::vector<Arc>& input, unsigned num_threads) {
+        num_threads = algorithms::utils::thread_count(num_threads);
+        // map tails to the vertices with the outgoing edges. An undirected edge touching
+        // a vertex with a capacity can't be a single pair anymore, it becomes two arcs.
+        std::vector<Arc> mapped{};
+        if(!m_out.empty()) {
+            mapped.reserve(input.size());
+            for(const Arc& arc : input) {
+                if(arc.undirected && (out(arc.tail) != arc.tail || out(arc.head) != arc.head)) {
+                    mapped.push_back({out(arc.tail), arc.head, arc.capacity});
+                    mapped.push_back({out(arc.head), arc.tail, arc.capacity});
+                } else {
+                    mapped.push_back({out(arc.tail), arc.head, arc.capacity, arc.undirected});
+                }
+            }
+        }
+        const std::vector<Arc>& arcs{m_out.empty() ? input : mapped};
+        // arc i is stored at first+2*i, its reverse edge at first+2*i+1
+        std::size_t first{m_edges.grow(2*arcs.size())};
+        // vertices are split into blocks of consecutive ids, one per thread. Each block
+        // gets a bucket of the edges to append to its lists, in arc order (counting sort).
+        std::size_t blocks{std::clamp<std::size_t>(num_threads, 1, std::max<I>(m_n, 1))};
+        std::size_t block_size{(static_cast<std::size_t>(m_n) + blocks - 1) / blocks};
+        auto block_of = [block_size](I vertex) { return static_cast<std::size_t>(vertex) / block_size; };
+        // count[t*blocks + b] = #edges of the arcs of thread t that go to block b
+        std::vector<std::size_t> count(num_threads * blocks, 0);
+        algorithms::utils::parallel_for(0, arcs.size(), num_threads, [&](unsigned id, std::size_t begin, std::size_t end) {
+            std::size_t* own_count{count.data() + id*blocks};
+            for(std::size_t i{begin}; i < end; ++i) {
+                const Arc& arc{arcs[i]};
+                Edge* edge = new (m_edges.at(first+2*i)) Edge{arc.tail, arc.head, arc.capacity};
+                Edge* reverse = new (m_edges.at(first+2*i+1)) Edge{arc.head, arc.tail, arc.undirected ? arc.capacity : 0};
+                edge->reverse = reverse;
+                reverse->reverse = edge;
+                // no self loops (their edges are stored but never used)
+                if(arc.tail == arc.head) { continue; }
+                ++own_count[block_of(arc.tail)];
+                ++own_count[block_of(arc.head)];
+            }
+        });
+        // offsets block by block, within a block thread by thread (= arc order)
+        std::vector<std::size_t> bucket_begin(blocks+1, 0);
+        std::size_t offset{0};
+        for(std::size_t b{0}; b < blocks; ++b) {
+            bucket_begin[b] = offset;
+            for(unsigned t{0}; t < num_threads; ++t) {
+                std::size_t edges{count[t*blocks + b]};
+                count[t*blocks + b] = offset;
+                offset += edges;
+            }
+        }
+        bucket_begin[blocks] = offset;
+        std::vector<std::size_t> buckets(offset);
+        algorithms::utils::parallel_for(0, arcs.size(), num_threads, [&](unsigned id, std::size_t begin, std::size_t end) {
+            std::size_t* next{count.data() + id*blocks};
+            for(std::size_t i{begin}; i < end; ++i) {
+                if(arcs[i].tail == arcs[i].head) { continue; }
+                buckets[next[block_of(arcs[i].tail)]++] = first+2*i;
+                buckets[next[block_of(arcs[i].head)]++] = first+2*i+1;
+            }
+        });
+        // room for the new edges first, appending then never moves a list. Only the vertices
+        // of these arcs are touched (loaders call this once per block of arcs): a bucket with
+        // many edges for its block is counted in an array over the block, a small one sorted.
+        std::vector<std::vector<std::pair<I, I>>> added(blocks);
+        algorithms::utils::parallel_for(0, blocks, blocks, [&](unsigned, std::size_t begin, std::size_t end) {
+            for(std::size_t b{begin}; b < end; ++b) {
+                std::size_t low{b*block_size};
+                std::size_t high{std::min<std::size_t>(m_n, low+block_size)};
+                std::size_t edges{bucket_begin[b+1] - bucket_begin[b]};
+                if(8*edges >= high - low) {
+                    std::vector<I> count(high - low, 0);
+                    for(std::size_t k{bucket_begin[b]}; k < bucket_begin[b+1]; ++k) {
+                        ++count[m_edges.at(buckets[k])->tail - low];
+                    }
+                    for(std::size_t v{0}; v < count.size(); ++v) {
+                        if(count[v] > 0) { added[b].emplace_back(static_cast<I>(low+v), count[v]); }
+                    }
+                    continue;
+                }
+                std::vector<I> tails{};
+                tails.reserve(edges);
+                for(std::size_t k{bucket_begin[b]}; k < bucket_begin[b+1]; ++k) {
+                    tails.push_back(m_edges.at(buckets[k])->tail);
+                }
+                std::ranges::sort(tails);
+                for(std::size_t k{0}; k < tails.size();) {
+                    std::size_t run{k};
+                    while(run < tails.size() && tails[run] == tails[k]) { ++run; }
+                    added[b].emplace_back(tails[k], static_cast<I>(run - k));
+                    k = run;
+                }
+            }
+        });
+        for(const auto& block : added) {
+            for(auto [vertex, count] : block) {
+                m_adj_list.reserve(vertex, m_adj_list[vertex].size() + count);
+            }
+        }
+        added.clear();
+        // every thread owns a block of vertices and only appends its bucket to their lists
+        algorithms::utils::parallel_for(0, blocks, blocks, [&](unsigned, std::size_t begin, std::size_t end) {
+            for(std::size_t k{bucket_begin[begin]}; k < bucket_begin[end]; ++k) {
+                Edge* edge{m_edges.at(buckets[k])};
+                m_adj_list.push_back(edge->tail, edge);
+            }
+        });
+    }
+
+    /**
+     * @brief Adds an undirected edge with the given capacity in both directions.
+     *        Stored as a single pair of edges, where each one is the reverse of 
+     *        the other, instead of two edges and two reverse edges.
+     * 
+     * @param u One end of the edge.
+     * @param v The other end of the edge.
+     * @param capacity Capacity in each direction.
+     */
+    template <typename T, typename I>
+    void Graph<T, I>::add_undirected_edge(I u, I v, T capacity) {
+        // no self loops
+        if(u == v) { return; }
+        // the halves of a split vertex need their own direction
+        if(out(u) != u || out(v) != v) {
+            add_edge(u, v, capacity);
+            add_edge(v, u, capacity);
+            return;
+        }
+
+        std::size_t index{m_edges.grow(2)};
+        Edge* edge = new (m_edges.at(index)) Edge{u, v, capacity};
+        Edge* reverse = new (m_edges.at(index+1)) Edge{v, u, capacity};
+
+        edge->reverse = reverse;
+        reverse->reverse = edge;
+
+        m_adj_list.push_back(u, edge);
+        m_adj_list.push_back(v, reverse);
+    }
+
+    /**
+     * @brief Limits the flow through a vertex. Has to be called before edges 
+     *        incident to the vertex are added (can be called again to change
+     *        the capacity).
+     * 
+     * @param vertex The vertex.
+     * @param capacity Maximum flow through the vertex.
+     */
+    template <typename T, typename I>
+    void Graph<T, I>::set_vertex_capacity(I vertex, T capacity) {
+        // all flow into a sink ends at its id and would never cross the inner edge
+        if(is_sink(vertex)) {
+            throw std::invalid_argument{"vertex " + std::to_string(vertex) + " is a sink, it can't have a vertex capacity"};
+        }
+        if(out(vertex) != vertex) {
+            // already split, only the capacity of the inner edge changes
+            Edge* inner{m_inner[vertex]};
+            inner->capacity = inner->back_up_capacity = capacity;
+            return;
+        }
+        assert(m_adj_list[vertex].empty() && "set vertex capacities before adding edges");
+        if(m_out.empty()) {
+            m_out.resize(m_n);
+            std::iota(m_out.begin(), m_out.end(), I{0});
+            m_inner.resize(m_n, nullptr);
+        }
+        I second_half{m_n};
+        ++m_n;
+        m_adj_list.add_vertex();
+        if(!m_terminal.empty()) { m_terminal.push_back(0); }
+        add_edge(vertex, second_half, capacity);
+        m_out[vertex] = second_half;
+        m_inner[vertex] = m_adj_list[vertex].back();
+    }
+
+    /**
+     * @brief Makes all given vertices sources, replaces m_s by the first one.
+     * 
+     * @param sources The sources, at least one.
+     */
+    template <typename T, typename I>
+    void Graph<T, I>::set_sources(const std::vector<I>& sources) {
+        set_terminals(sources, m_sources, m_s, source_flag);
+    }
+
+    /**
+     * @brief Makes all given vertices sinks, replaces m_t by the first one.
+     * 
+     * @param sinks The sinks, at least one.
+     */
+    template <typename T, typename I>
+    void Graph<T, I>::set_sinks(const std::vector<I>& sinks) {
+        set_terminals(sinks, m_sinks, m_t, sink_flag);
+    }
+
+    template <typename T, typename I>
+    void Graph<T, I>::set_terminals(const std::vector<I>& given, std::vector<I>& terminals, I& single, unsigned char flag) {
+        assert(!given.empty() && "at least one terminal");
+        // a vertex that is source and sink at once makes the searches loop forever
+        for(I v : given) {
+            if(flag == source_flag ? is_sink(v) : is_source(v)) {
+                throw std::invalid_argument{"vertex " + std::to_string(v) + " is already a "
+                    + (flag == source_flag ? "sink" : "source")};
+            }
+            if(flag == sink_flag && out(v) != v) {
+                throw std::invalid_argument{"vertex " + std::to_string(v) + " has a vertex capacity, it can't be a sink"};
+            }
+        }
+        for(I v : terminals) { m_terminal[v] &= ~flag; }
+        single = given.front();
+        if(given.size() == 1) {
+            terminals.clear();
+        } else {
+            terminals = given;
+            m_terminal.resize(m_n, 0);
+            for(I v : terminals) { m_terminal[v] |= flag; }
+        }
+        if(m_sources.empty() && m_sinks.empty()) { m_terminal.clear(); }
     }
 
     /**
      * @brief Shuffles the adjacency list.
+     * 
+     * @return unsigned int The seed used, shuffle_edges(seed) repeats the shuffle.
      */
-    template <typename T>
-    void Graph<T>::shuffle_edges() {
-        for(int i{0}; i < m_n; ++i) {
-            auto rd{std::random_device{}};
-            auto rng{std::default_random_engine{rd()}};
-            std::shuffle(m_adj_list[i].begin(), m_adj_list[i].end(), rng);
+    template <typename T, typename I>
+    unsigned int Graph<T, I>::shuffle_edges() {
+        unsigned int seed{std::random_device{}()};
+        shuffle_edges(seed);
+        return seed;
+    }
+
+    /**
+     * @brief Shuffles the adjacency list reproducibly.
+     * 
+     * @param seed Seed of the random engine.
+     */
+    template <typename T, typename I>
+    void Graph<T, I>::shuffle_edges(unsigned int seed) {
+        // one engine for all vertices
+        std::mt19937 rng{seed};
+        for(I i{0}; i < m_n; ++i) {
+            auto edges{m_adj_list[i]};
+            std::shuffle(edges.begin(), edges.end(), rng);
         }
     }
 
     /**
-     * @brief Restore each edge capacity.
+     * @brief Relabels the vertices and sorts every adjacency list by head, 
+     *        see ds::reorder for orders that keep neighbours close in memory.
+     * 
+     * @param order order[k] = the vertex that gets id k. (A permutation of all vertices)
      */
-    template <typename T>
-    void Graph<T>::restore() {
-        for(int i{0}; i < m_adj_list.size(); ++i) {
-            for(int j{0}; j < m_adj_list[i].size(); ++j) {
-                m_adj_list[i][j]->restore();
+    template <typename T, typename I>
+    void Graph<T, I>::relabel(const std::vector<I>& order) {
+        assert(static_cast<I>(order.size()) == m_n);
+        std::vector<I> new_id(m_n);
+        for(I k{0}; k < m_n; ++k) {
+            new_id[order[k]] = k;
+        }
+        m_edges.for_each([&new_id](Edge& edge) {
+            edge.tail = new_id[edge.tail];
+            edge.head = new_id[edge.head];
+        });
+        // the new lists are stored in the new order and without gaps
+        AdjacencyLists<Edge*, I> adj_list{m_n, m_edges.options()};
+        for(I k{0}; k < m_n; ++k) {
+            auto edges{m_adj_list[order[k]]};
+            adj_list.reserve(k, edges.size());
+            for(Edge* edge : edges) { adj_list.push_back(k, edge); }
+            // neighbours in increasing order, so label/level lookups walk forward in memory
+            auto sorted{adj_list[k]};
+            std::stable_sort(sorted.begin(), sorted.end(), [](const Edge* a, const Edge* b) {
+                return a->head < b->head;
+            });
+        }
+        m_adj_list = std::move(adj_list);
+        m_s = new_id[m_s];
+        m_t = new_id[m_t];
+        for(I& v : m_sources) { v = new_id[v]; }
+        for(I& v : m_sinks) { v = new_id[v]; }
+        if(!m_terminal.empty()) {
+            std::vector<unsigned char> terminal(m_n);
+            for(I k{0}; k < m_n; ++k) {
+                terminal[k] = m_terminal[order[k]];
+            }
+            m_terminal = std::move(terminal);
+        }
+        if(!m_out.empty()) {
+            std::vector<I> out(m_n);
+            std::vector<Edge*> inner(m_n, nullptr);
+            for(I v{0}; v < m_n; ++v) {
+                out[new_id[v]] = new_id[this->out(v)];
+                if(v < static_cast<I>(m_inner.size())) { inner[new_id[v]] = m_inner[v]; }
             }
+            m_out = std::move(out);
+            m_inner = std::move(inner);
+        }
+        // compose with earlier relabelings
+        std::vector<I> original_id(m_n);
+        for(I k{0}; k < m_n; ++k) {
+            original_id[k] = this->original_id(order[k]);
+        }
+        m_original_id = std::move(original_id);
+        m_current_id.assign(m_n, 0);
+        for(I k{0}; k < m_n; ++k) {
+            m_current_id[m_original_id[k]] = k;
         }
     }
 
+    /**
+     * @brief Restore each edge capacity.
+     */
+    template <typename T, typename I>
+    void Graph<T, I>::restore() {
+        // walks the edges in storage order instead of chasing the adjacency lists
+        m_edges.for_each([](Edge& edge) { edge.restore(); });
+    }
+
     // for debugging purposes
-    template <typename T>
-    void Graph<T>::print_graph() {
-        std::cout << "Source: " << m_s << "\n";
-        std::cout << "Sink: " << m_t << "\n";
+    template <typename T, typename I>
+    void Graph<T, I>::print_graph() {
+        std::cout << "Source:";
+        for(I v : sources()) { std::cout << " " << v; }
+        std::cout << "\nSink:";
+        for(I v : sinks()) { std::cout << " " << v; }
+        std::cout << "\n";
         std::cout << "Edges: \n";
-        for(int i{0}; i < m_adj_list.size(); ++i) {
-            for(int j{0}; j < m_adj_list[i].size(); ++j) {
+        for(I i{0}; i < m_n; ++i) {
+            for(std::size_t j{0}; j < m_adj_list[i].size(); ++j) {
                 Edge* edge = m_adj_list[i][j];
                 std::cout << edge->tail+1 << " -" << edge->capacity << "-> " << edge->head+1 << " ";
             }
@@ -109,4 +414,4 @@ namespace ds {
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,97 @@
+#ifndef LINK_CUT_TREE_H
+#define LINK_CUT_TREE_H
+
+#include <vector>
+#include <array>
+
+namespace ds {
+
+    /**
+     * @brief Forest of rooted trees (Sleator-Tarjan dynamic trees) on the vertices 0..n-1,
+     *        represented by splay trees over preferred paths. Every vertex but a root has
+     *        a value (the residual capacity of the edge to its parent in dinic's). All
+     *        operations take O(log n) amortized time.
+     *
+     * @tparam T Value type.
+     * @tparam I Index type.
+     */
+    template <typename T, typename I>
+    class LinkCutTree {
+
+        public:
+            /**
+             * @brief Makes n single vertex trees.
+             */
+            void reset(I n);
+
+            /**
+             * @brief The root of the tree containing the vertex.
+             */
+            I find_root(I vertex);
+
+            /**
+             * @brief Minimal value on the path from the vertex up to its root (root excluded),
+             *        max of T if the vertex is a root.
+             */
+            T path_min(I vertex);
+
+            /**
+             * @brief The vertex closest to the root with the minimal value on the path
+             *        from the given vertex up to its root (root excluded), -1 if the vertex is a root.
+             */
+            I path_min_vertex(I vertex);
+
+            /**
+             * @brief Adds delta to the value of every vertex on the path from the vertex
+             *        up to its root (root excluded).
+             */
+            void path_add(I vertex, T delta);
+
+            /**
+             * @brief Makes the root vertex a child of parent, with the given value.
+             *
+             * @param vertex A root, not in the tree of parent.
+             * @param parent The new parent.
+             * @param value The value of the vertex.
+             */
+            void link(I vertex, I parent, T value);
+
+            /**
+             * @brief Removes the edge from the vertex to its parent, the vertex becomes a root.
+             *
+             * @param vertex A vertex that is not a root.
+             * @return T The value the vertex had.
+             */
+            T cut(I vertex);
+
+        private:
+            // -1 = no child/parent. The parent of the root of a splay tree is the
+            // "path-parent": the parent (in the represented tree) of the topmost vertex of the path
+            std::vector<std::array<I, 2>> m_child{};
+            std::vector<I> m_parent{};
+            std::vector<T> m_value{};
+            // minimal value in the splay subtree
+            std::vector<T> m_min{};
+            // lazy add, already applied to the vertex itself but not to its splay children
+            std::vector<T> m_add{};
+            std::vector<I> m_stack{};
+
+            bool is_splay_root(I vertex) const;
+            T subtree_min(I vertex) const;
+            void apply(I vertex, T delta);
+            void push(I vertex);
+            void pull(I vertex);
+            void rotate(I vertex);
+            void splay(I vertex);
+            void access(I vertex);
+            /**
+             * @brief find_root, leaves the root at the top of the splay tree of the path
+             *        from the vertex to the root, its right subtree holds the rest of the path.
+             */
+            I expose(I vertex);
+    };
+}
+
+#include "linkcuttree.ipp"
+
+#endif
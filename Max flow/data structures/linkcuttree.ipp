@@ -0,0 +1,209 @@
+#ifndef LINK_CUT_TREE_IPP
+#define LINK_CUT_TREE_IPP
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+namespace ds {
+
+    /**
+     * @brief Makes n single vertex trees.
+     */
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::reset(I n) {
+        m_child.assign(n, {-1, -1});
+        m_parent.assign(n, -1);
+        m_value.assign(n, std::numeric_limits<T>::max());
+        m_min.assign(n, std::numeric_limits<T>::max());
+        m_add.assign(n, 0);
+    }
+
+    template <typename T, typename I>
+    bool LinkCutTree<T, I>::is_splay_root(I vertex) const {
+        I parent{m_parent[vertex]};
+        return parent == -1 || (m_child[parent][0] != vertex && m_child[parent][1] != vertex);
+    }
+
+    template <typename T, typename I>
+    T LinkCutTree<T, I>::subtree_min(I vertex) const {
+        return vertex == -1 ? std::numeric_limits<T>::max() : m_min[vertex];
+    }
+
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::apply(I vertex, T delta) {
+        if(vertex == -1) { return; }
+        m_value[vertex] += delta;
+        m_min[vertex] += delta;
+        m_add[vertex] += delta;
+    }
+
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::push(I vertex) {
+        if(m_add[vertex] == 0) { return; }
+        apply(m_child[vertex][0], m_add[vertex]);
+        apply(m_child[vertex][1], m_add[vertex]);
+        m_add[vertex] = 0;
+    }
+
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::pull(I vertex) {
+        m_min[vertex] = std::min({m_value[vertex], subtree_min(m_child[vertex][0]), subtree_min(m_child[vertex][1])});
+    }
+
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::rotate(I vertex) {
+        I parent{m_parent[vertex]};
+        I grandparent{m_parent[parent]};
+        int side{m_child[parent][1] == vertex};
+        if(!is_splay_root(parent)) {
+            m_child[grandparent][m_child[grandparent][1] == parent] = vertex;
+        }
+        // also takes over the path-parent
+        m_parent[vertex] = grandparent;
+        I moved{m_child[vertex][!side]};
+        m_child[parent][side] = moved;
+        if(moved != -1) { m_parent[moved] = parent; }
+        m_child[vertex][!side] = parent;
+        m_parent[parent] = vertex;
+        pull(parent);
+        pull(vertex);
+    }
+
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::splay(I vertex) {
+        // lazy adds have to reach the vertex before rotating
+        m_stack.clear();
+        for(I current{vertex}; ; current = m_parent[current]) {
+            m_stack.push_back(current);
+            if(is_splay_root(current)) { break; }
+        }
+        for(auto it{m_stack.rbegin()}; it != m_stack.rend(); ++it) {
+            push(*it);
+        }
+        while(!is_splay_root(vertex)) {
+            I parent{m_parent[vertex]};
+            if(!is_splay_root(parent)) {
+                I grandparent{m_parent[parent]};
+                bool zig_zig{(m_child[grandparent][0] == parent) == (m_child[parent][0] == vertex)};
+                rotate(zig_zig ? parent : vertex);
+            }
+            rotate(vertex);
+        }
+    }
+
+    /**
+     * @brief Makes the path from the root to the vertex preferred, ending at the vertex.
+     *        The vertex ends up at the top of its splay tree without a right child.
+     */
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::access(I vertex) {
+        I last{-1};
+        for(I current{vertex}; current != -1; current = m_parent[current]) {
+            splay(current);
+            m_child[current][1] = last;
+            pull(current);
+            last = current;
+        }
+        splay(vertex);
+    }
+
+    template <typename T, typename I>
+    I LinkCutTree<T, I>::expose(I vertex) {
+        access(vertex);
+        // the root is the leftmost vertex of the path
+        I root{vertex};
+        push(root);
+        while(m_child[root][0] != -1) {
+            root = m_child[root][0];
+            push(root);
+        }
+        splay(root);
+        return root;
+    }
+
+    /**
+     * @brief The root of the tree containing the vertex.
+     */
+    template <typename T, typename I>
+    I LinkCutTree<T, I>::find_root(I vertex) {
+        return expose(vertex);
+    }
+
+    /**
+     * @brief Minimal value on the path from the vertex up to its root (root excluded),
+     *        max of T if the vertex is a root.
+     */
+    template <typename T, typename I>
+    T LinkCutTree<T, I>::path_min(I vertex) {
+        I root{expose(vertex)};
+        return subtree_min(m_child[root][1]);
+    }
+
+    /**
+     * @brief The vertex closest to the root with the minimal value on the path
+     *        from the given vertex up to its root (root excluded), -1 if the vertex is a root.
+     */
+    template <typename T, typename I>
+    I LinkCutTree<T, I>::path_min_vertex(I vertex) {
+        I root{expose(vertex)};
+        I current{m_child[root][1]};
+        if(current == -1) { return -1; }
+        T min{m_min[current]};
+        while(true) {
+            push(current);
+            if(subtree_min(m_child[current][0]) == min) {
+                current = m_child[current][0];
+            } else if(m_value[current] == min) {
+                break;
+            } else {
+                current = m_child[current][1];
+            }
+        }
+        splay(current);
+        return current;
+    }
+
+    /**
+     * @brief Adds delta to the value of every vertex on the path from the vertex
+     *        up to its root (root excluded).
+     */
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::path_add(I vertex, T delta) {
+        I root{expose(vertex)};
+        apply(m_child[root][1], delta);
+        pull(root);
+    }
+
+    /**
+     * @brief Makes the root vertex a child of parent, with the given value.
+     */
+    template <typename T, typename I>
+    void LinkCutTree<T, I>::link(I vertex, I parent, T value) {
+        // a root is the leftmost vertex of its path, the whole path hangs below parent
+        splay(vertex);
+        assert(m_child[vertex][0] == -1 && m_parent[vertex] == -1 && "only roots can be linked");
+        m_value[vertex] = value;
+        pull(vertex);
+        m_parent[vertex] = parent;
+    }
+
+    /**
+     * @brief Removes the edge from the vertex to its parent, the vertex becomes a root.
+     */
+    template <typename T, typename I>
+    T LinkCutTree<T, I>::cut(I vertex) {
+        access(vertex);
+        I above{m_child[vertex][0]};
+        assert(above != -1 && "roots cannot be cut");
+        m_parent[above] = -1;
+        m_child[vertex][0] = -1;
+        T value{m_value[vertex]};
+        m_value[vertex] = std::numeric_limits<T>::max();
+        pull(vertex);
+        return value;
+    }
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef ORDERING_H
+#define ORDERING_H
+
+#include "graph.h"
+
+#include <vector>
+
+namespace ds {
+
+    /**
+     * @brief Vertex orders for ds::reorder.
+     */
+    enum class VertexOrder {
+        // breadth-first search from the sources
+        bfs,
+        // reverse Cuthill-McKee, small bandwidth
+        reverse_cuthill_mckee,
+        // recursive bisection into blocks of neighbouring vertices
+        partition
+    };
+
+    /**
+     * @brief Computes the breadth-first order from the sources (other components follow).
+     * 
+     * @return std::vector<I> order[k] = the vertex at position k.
+     */
+    template <typename T, typename I>
+    std::vector<I> bfs_order(const Graph<T, I>& graph);
+
+    /**
+     * @brief Computes the reverse Cuthill-McKee order, every component
+     *        starting at a pseudo-peripheral vertex.
+     * 
+     * @return std::vector<I> order[k] = the vertex at position k.
+     */
+    template <typename T, typename I>
+    std::vector<I> reverse_cuthill_mckee_order(const Graph<T, I>& graph);
+
+    /**
+     * @brief Computes an order where the graph is recursively bisected along
+     *        breadth-first levels until every part has at most block_size vertices.
+     *        Parts are laid out one after the other.
+     * 
+     * @param block_size Maximum number of vertices per part.
+     * @return std::vector<I> order[k] = the vertex at position k.
+     */
+    template <typename T, typename I>
+    std::vector<I> partition_order(const Graph<T, I>& graph, I block_size=1024);
+
+    /**
+     * @brief Relabels the vertices of the graph in the given order and sorts the
+     *        adjacency lists by head, so that labels[edge->head] and level[edge->head]
+     *        of neighbouring vertices are close in memory. Use graph.original_id
+     *        and graph.current_id to map between old and new ids.
+     * 
+     * @param graph The residual network.
+     * @param order The order to use.
+     */
+    template <typename T, typename I>
+    void reorder(Graph<T, I>& graph, VertexOrder order);
+}
+
+#include "ordering.ipp"
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef ORDERING_IPP
+#define ORDERING_IPP
+
+#include "graph.h"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace ds {
+
+    /**
+     * @brief Breadth-first search over the adjacency lists (ignoring capacities),
+     *        only entering vertices for which allowed(v) holds.
+     * 
+     * @param graph The residual network.
+     * @param start The first vertex.
+     * @param dist Distances, -1 for unvisited vertices. Visited vertices are set.
+     * @param allowed Which vertices can be visited.
+     * @return std::vector<I> The visited vertices in breadth-first order.
+     */
+    template <typename T, typename I>
+    std::vector<I> restricted_bfs(const Graph<T, I>& graph, I start, std::vector<I>& dist, auto&& allowed) {
+        std::vector<I> visited{start};
+        dist[start] = 0;
+        // visited doubles as the queue
+        for(std::size_t i{0}; i < visited.size(); ++i) {
+            I vertex{visited[i]};
+            for(auto* edge : graph.m_adj_list[vertex]) {
+                if(dist[edge->head] != -1 || !allowed(edge->head)) { continue; }
+                dist[edge->head] = dist[vertex]+1;
+                visited.push_back(edge->head);
+            }
+        }
+        return visited;
+    }
+
+    /**
+     * @brief Computes the breadth-first order from the sources (other components follow).
+     * 
+     * @return std::vector<I> order[k] = the vertex at position k.
+     */
+    template <typename T, typename I>
+    std::vector<I> bfs_order(const Graph<T, I>& graph) {
+        std::vector<I> dist(graph.m_n, -1);
+        std::vector<I> order{};
+        order.reserve(graph.m_n);
+        auto visit = [&](I start) {
+            if(dist[start] != -1) { return; }
+            auto component{restricted_bfs(graph, start, dist, [](I) { return true; })};
+            order.insert(order.end(), component.begin(), component.end());
+        };
+        for(I source : graph.sources()) {
+            visit(source);
+        }
+        for(I v{0}; v < graph.m_n; ++v) {
+            visit(v);
+        }
+        return order;
+    }
+
+    /**
+     * @brief Computes the reverse Cuthill-McKee order, every component
+     *        starting at a pseudo-peripheral vertex.
+     * 
+     * @return std::vector<I> order[k] = the vertex at position k.
+     */
+    template <typename T, typename I>
+    std::vector<I> reverse_cuthill_mckee_order(const Graph<T, I>& graph) {
+        auto degree = [&graph](I v) { return graph.m_adj_list[v].size(); };
+        auto all = [](I) { return true; };
+        std::vector<I> dist(graph.m_n, -1);
+        std::vector<char> placed(graph.m_n, 0);
+        std::vector<I> order{};
+        order.reserve(graph.m_n);
+        std::vector<I> neighbours{};
+        for(I v{0}; v < graph.m_n; ++v) {
+            if(placed[v]) { continue; }
+            // pseudo-peripheral vertex: minimal degree vertex of the last level, until the eccentricity stops growing
+            I start{v};
+            I eccentricity{-1};
+            while(true) {
+                auto component{restricted_bfs(graph, start, dist, all)};
+                I last_level{dist[component.back()]};
+                I candidate{component.back()};
+                for(auto it{component.rbegin()}; it != component.rend() && dist[*it] == last_level; ++it) {
+                    if(degree(*it) < degree(candidate)) { candidate = *it; }
+                }
+                for(I u : component) { dist[u] = -1; }
+                if(last_level <= eccentricity) { break; }
+                eccentricity = last_level;
+                start = candidate;
+            }
+            // Cuthill-McKee: breadth-first, neighbours by increasing degree
+            std::size_t first{order.size()};
+            order.push_back(start);
+            placed[start] = 1;
+            for(std::size_t i{first}; i < order.size(); ++i) {
+                neighbours.clear();
+                for(auto* edge : graph.m_adj_list[order[i]]) {
+                    if(placed[edge->head]) { continue; }
+                    placed[edge->head] = 1;
+                    neighbours.push_back(edge->head);
+                }
+                std::stable_sort(neighbours.begin(), neighbours.end(), [&degree](I a, I b) {
+                    return degree(a) < degree(b);
+                });
+                order.insert(order.end(), neighbours.begin(), neighbours.end());
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    /**
+     * @brief Computes an order where the graph is recursively bisected along
+     *        breadth-first levels until every part has at most block_size vertices.
+     *        Parts are laid out one after the other.
+     * 
+     * @param block_size Maximum number of vertices per part.
+     * @return std::vector<I> order[k] = the vertex at position k.
+     */
+    template <typename T, typename I>
+    std::vector<I> partition_order(const Graph<T, I>& graph, I block_size) {
+        std::vector<I> order(graph.m_n);
+        for(I v{0}; v < graph.m_n; ++v) { order[v] = v; }
+        // part[v] = the part v currently belongs to, parts are the ranges on the stack
+        std::vector<I> part(graph.m_n, 0);
+        std::vector<I> dist(graph.m_n, -1);
+        I parts{1};
+        // (begin, end) ranges of order still to bisect
+        std::vector<std::pair<std::size_t, std::size_t>> to_bisect{{0, order.size()}};
+        block_size = std::max<I>(block_size, 1);
+        while(!to_bisect.empty()) {
+            auto [begin, end] = to_bisect.back();
+            to_bisect.pop_back();
+            if(end - begin <= static_cast<std::size_t>(block_size)) { continue; }
+            I id{part[order[begin]]};
+            auto inside = [&part, id](I v) { return part[v] == id; };
+            // the farthest vertex from any vertex is a good start for the level structure
+            auto sweep{restricted_bfs(graph, order[begin], dist, inside)};
+            I start{sweep.back()};
+            for(I u : sweep) { dist[u] = -1; }
+            sweep = restricted_bfs(graph, start, dist, inside);
+            // split by distance, vertices not reached (other components of the part) last
+            std::stable_sort(order.begin()+begin, order.begin()+end, [&dist](I a, I b) {
+                auto key = [&dist](I v) { return dist[v] == -1 ? std::numeric_limits<I>::max() : dist[v]; };
+                return key(a) < key(b);
+            });
+            for(I u : sweep) { dist[u] = -1; }
+            std::size_t middle{begin + (end-begin)/2};
+            for(std::size_t i{middle}; i < end; ++i) {
+                part[order[i]] = parts;
+            }
+            ++parts;
+            to_bisect.emplace_back(middle, end);
+            to_bisect.emplace_back(begin, middle);
+        }
+        return order;
+    }
+
+    /**
+     * @brief Relabels the vertices of the graph in the given order and sorts the
+     *        adjacency lists by head.
+     * 
+     * @param graph The residual network.
+     * @param order The order to use.
+     */
+    template <typename T, typename I>
+    void reorder(Graph<T, I>& graph, VertexOrder order) {
+        switch(order) {
+            case VertexOrder::bfs:
+                graph.relabel(bfs_order(graph));
+                break;
+            case VertexOrder::reverse_cuthill_mckee:
+                graph.relabel(reverse_cuthill_mckee_order(graph));
+                break;
+            case VertexOrder::partition:
+                graph.relabel(partition_order(graph));
+                break;
+        }
+    }
+}
+
+#endif
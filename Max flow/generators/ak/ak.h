@@ -10,6 +10,9 @@
 
 // translated to C++ and to be able to write to files
 
+#include "../network.h"
+#include "../../data structures/graph.h"
+
 #include <iostream>
 
 namespace generators {
@@ -25,6 +28,25 @@ namespace generators {
          * @param n The parameter needed to generate the network.
          */
         void generate(int n);
+
+        /**
+         * @brief Generates the ak max flow problem in memory, the arcs of
+         *        each part of the network are written in parallel.
+         * 
+         * @param n The parameter needed to generate the network.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @return Network The generated problem.
+         */
+        Network generate_network(int n, unsigned num_threads=0);
+
+        /**
+         * @brief Generates the ak max flow problem directly as a residual network.
+         * 
+         * @param n The parameter needed to generate the network.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @return ds::Graph<int> The residual network.
+         */
+        ds::Graph<int> generate_graph(int n, unsigned num_threads=0);
     
     }
 }
@@ -9,6 +9,10 @@
     translated to C++ and changed a few things to integrate the generator into my project
 
 */
+
+#include "../network.h"
+#include "../../data structures/graph.h"
+
 namespace generators {
     
     namespace genrmf {
@@ -24,6 +28,36 @@ namespace generators {
          */
         void generate(int a, int b, int c1, int c2, int seed=-1);
 
+        /**
+         * @brief Generate a genrmf max flow problem in memory. The frames are generated
+         *        in parallel, each frame using its own random stream derived from the seed,
+         *        so the result only depends on the parameters and not on the number of threads.
+         *        (The instance differs from the one written by generate with the same seed.)
+         * 
+         * @param a Frame size.
+         * @param b Depth.
+         * @param c1 min capacity.
+         * @param c2 max capacity.
+         * @param seed Seed for the random capacities.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @return Network The generated problem.
+         */
+        Network generate_network(int a, int b, int c1, int c2, int seed=-1, unsigned num_threads=0);
+
+        /**
+         * @brief Generate a genrmf max flow problem directly as a residual network.
+         *        See generate_network.
+         * 
+         * @param a Frame size.
+         * @param b Depth.
+         * @param c1 min capacity.
+         * @param c2 max capacity.
+         * @param seed Seed for the random capacities.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @return ds::Graph<int> The residual network.
+         */
+        ds::Graph<int> generate_graph(int a, int b, int c1, int c2, int seed=-1, unsigned num_threads=0);
+
     }
 }
 
@@ -0,0 +1,56 @@
+#ifndef NETWORK_H
+#define NETWORK_H
+
+#include "../data structures/graph.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace generators {
+
+    /**
+     * @brief A generated max flow problem kept in memory. Vertices are 0-indexed.
+     *
+     *        Can be turned into a residual network directly, or optionally written
+     *        out as a .dimacs file or as a binary snapshot.
+     */
+    struct Network {
+        int n{0};
+        int s{0};
+        int t{0};
+        std::vector<ds::Graph<int>::Arc> arcs{};
+        // written as "c" lines to .dimacs files
+        std::vector<std::string> comments{};
+    };
+
+    /**
+     * @brief Builds the residual network of a generated problem.
+     * 
+     * @param network The generated problem.
+     * @param num_threads Number of threads to use (0 = all hardware threads).
+     * @return ds::Graph<int> The residual network.
+     */
+    ds::Graph<int> to_graph(const Network& network, unsigned num_threads=0);
+
+    /**
+     * @brief Writes the problem in .dimacs format.
+     * 
+     * @param network The generated problem.
+     * @param path Where to save the file.
+     */
+    void write_dimacs(const Network& network, std::string_view path);
+
+    /**
+     * @brief Writes the problem as a binary snapshot, readable with io::load_graph_from_binary.
+     * 
+     *        Layout (native byte order, 64-bit signed integers): "MFGRAPH1", n, m, s, t,
+     *        followed by m (tail, head, capacity) triples.
+     * 
+     * @param network The generated problem.
+     * @param path Where to save the file.
+     */
+    void write_binary(const Network& network, std::string_view path);
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define BENCHMARK_H
 
 #include "../data structures/graph.h"
+#include "../algorithms/solve.h"
 
 #include <string_view>
 
@@ -10,26 +11,46 @@
           execution of each algorithm.
  * 
  * @tparam T Flow type.
+ * @tparam I Index type.
  * @param graph The residual network to test.
  * @param num_of_runs The number of runs per algorithm.
  */
  // add return for results?
-template <typename T>
-void start(ds::Graph<T>& graph, int num_of_runs=1);
+template <typename T, typename I>
+void start(ds::Graph<T, I>& graph, int num_of_runs=1);
 
 /**
  * @brief Function to benchmark a max flow algorithm given by the function pointer.
  * 
  * @tparam T Flow type.
+ * @tparam I Index type.
  * @param graph The residual network.
  * @param mf_algorithm Function pointer to the algorithm we want to time.
  * @return auto pair of (elapsed_time [ms], computed max flow)
  */
-template <typename T>
-auto benchmark(ds::Graph<T>& graph, T (* mf_algorithm) (ds::Graph<T>& graph));
+template <typename T, typename I>
+auto benchmark(ds::Graph<T, I>& graph, T (* mf_algorithm) (ds::Graph<T, I>& graph));
 
+/**
+ * @brief Times algorithms::solve with features computed once before all runs.
+ * 
+ * @tparam T Flow type.
+ * @tparam I Index type.
+ * @param graph The residual network.
+ * @param features algorithms::graph_features of the network.
+ * @return auto pair of (elapsed_time [ms], result of solve with the engine it chose)
+ */
+template <typename T, typename I>
+auto benchmark_solve(ds::Graph<T, I>& graph, const algorithms::GraphFeatures<T>& features);
+
+/**
+ * @brief Prints the flow, time and counters of an algorithm.
+ * 
+ * @param certificate_error The first failed check of verify_max_flow over all runs, empty if all passed.
+ */
 template <typename T>
-void printResult(T result_max_flow, auto result_time, std::string_view algorithm_used, int num_of_runs=1);
+void printResult(T result_max_flow, auto result_time, std::string_view algorithm_used, int num_of_runs, 
+    std::string_view certificate_error);
 
 #include "benchmark.ipp"
 
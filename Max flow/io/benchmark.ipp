@@ -7,8 +7,11 @@
 #include "../algorithms/fordfulkerson.h"
 #include "../algorithms/edmondskarp.h"
 #include "../algorithms/dinic.h"
+#include "../algorithms/dinicdt.h"
 #include "../algorithms/pushrelabel.h"
 #include "../algorithms/hipushrelabel.h"
+#include "../algorithms/verify.h"
+#include "../algorithms/solve.h"
 
 
 #include <map>
@@ -20,6 +23,8 @@ void resetCounters() {
     counters::ff_edges_visited = 0;
     counters::ek_edges_visited = 0;
     counters::dinic_edges_visited = 0;
+    counters::dinic_dt_edges_visited = 0;
+    counters::dinic_dt_augmenting_paths = 0;
     counters::hi_pr_pushes = 0;
     counters::hi_pr_relabels = 0;
     counters::pr_pushes = 0;
@@ -31,39 +36,80 @@ void resetCounters() {
           execution of each algorithm.
  * 
  * @tparam T Flow type.
+ * @tparam I Index type.
  * @param graph The residual network to test.
  * @param num_of_runs The number of runs per algorithm.
  */
  // add return for results?
-template <typename T>
-void start(ds::Graph<T>& graph, int num_of_runs) { 
-    using mf_algorithm = T (*) (ds::Graph<T>& graph);
+template <typename T, typename I>
+void start(ds::Graph<T, I>& graph, int num_of_runs) { 
+    using mf_algorithm = T (*) (ds::Graph<T, I>& graph);
+    using algorithms::FlowKind;
 
     num_of_runs = std::max(num_of_runs, 1);
-    std::map<std::string, mf_algorithm> to_check = {
-       {"FORD-FULKERSON DFS"                , &algorithms::ford_fulkerson},
-       {"EDMONDS-KARP"                      , &algorithms::edmonds_karp},
-       {"DINIC'S"                           , &algorithms::dinic},
-       {"PUSH-RELABEL"                      , &algorithms::push_relabel},
-       {"HIGHEST LABEL PUSH-RELABEL + GAP"  , &algorithms::hi_push_relabel}
+    // the push-relabel algorithms leave a preflow
+    std::map<std::string, std::pair<mf_algorithm, FlowKind>> to_check = {
+       {"FORD-FULKERSON DFS"                , {&algorithms::ford_fulkerson<T, I>, FlowKind::flow}},
+       {"EDMONDS-KARP"                      , {&algorithms::edmonds_karp<T, I>, FlowKind::flow}},
+       {"EDMONDS-KARP BIDIRECTIONAL"        , {&algorithms::edmonds_karp_bidirectional<T, I>, FlowKind::flow}},
+       {"DINIC'S"                           , {&algorithms::dinic<T, I>, FlowKind::flow}},
+       {"DINIC'S + DYNAMIC TREES"           , {&algorithms::dinic_dynamic_trees<T, I>, FlowKind::flow}},
+       {"PUSH-RELABEL"                      , {&algorithms::push_relabel<T, I>, FlowKind::preflow}},
+       {"HIGHEST LABEL PUSH-RELABEL + GAP"  , {&algorithms::hi_push_relabel<T, I>, FlowKind::preflow}}
     };
 
     std::chrono::microseconds::rep elapsed_time{};
     T max_flow{0};
+    // first failed certificate check of the runs, empty if all passed
+    std::string certificate_error{};
     // remember max flow values computed and their average times
     //std::map<std::string, T> max_flows{};
+
+    // AUTO picks its engine per network, the certificate and the output follow the timed runs.
+    // The features are computed once, like a loader would, and timed on their own.
+    auto features_start{std::chrono::steady_clock::now()};
+    auto features{algorithms::graph_features(graph)};
+    auto features_time{std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - features_start).count()};
+    algorithms::EngineChoice choice{};
+    for(int i{0}; i < num_of_runs; ++i) {
+        auto result{benchmark_solve(graph, features)};
+        auto certificate{algorithms::verify_max_flow(graph, result.second.flow, 
+            algorithms::flow_kind(result.second.choice.engine))};
+        if(!certificate.valid && certificate_error.empty()) {
+            certificate_error = certificate.error;
+        }
+        graph.restore();
+        elapsed_time += result.first;
+        max_flow = result.second.flow;
+        choice = result.second.choice;
+    }
+    printResult(max_flow, elapsed_time, "AUTO", num_of_runs, certificate_error);
+    std::cout << "Engine: " << algorithms::engine_name(choice.engine) << ", " << choice.reason << "\n";
+    std::cout << "Features computed once in " << features_time << " ms.\n";
+    resetCounters();
+    elapsed_time = 0;
+    max_flow = 0;
+    certificate_error.clear();
+
     for(auto const& algorithm : to_check) {
         for(int i{0}; i < num_of_runs; ++i) {
             // TODO: generate new graph with the same number of nodes and edges in each run
-            auto result{benchmark(graph, algorithm.second)};
+            auto result{benchmark(graph, algorithm.second.first)};
+            // checked before restoring the capacities, not part of the time
+            auto certificate{algorithms::verify_max_flow(graph, result.second, algorithm.second.second)};
+            if(!certificate.valid && certificate_error.empty()) {
+                certificate_error = certificate.error;
+            }
             graph.restore();
             elapsed_time += result.first;
             max_flow = result.second;
         }
-        printResult(max_flow, elapsed_time, algorithm.first, num_of_runs);
+        printResult(max_flow, elapsed_time, algorithm.first, num_of_runs, certificate_error);
         resetCounters();
         elapsed_time = 0;
         max_flow = 0;
+        certificate_error.clear();
     }
 }
 
@@ -71,12 +117,13 @@ void start(ds::Graph<T>& graph, int num_of_runs) {
  * @brief Function to benchmark a max flow algorithm given by the function pointer.
  * 
  * @tparam T Flow type.
+ * @tparam I Index type.
  * @param graph The residual network.
  * @param mf_algorithm Function pointer to the algorithm we want to time.
  * @return auto pair of (elapsed_time [ms], computed max flow)
  */
-template <typename T>
-auto benchmark(ds::Graph<T>& graph, T (* mf_algorithm) (ds::Graph<T>& graph)) {
+template <typename T, typename I>
+auto benchmark(ds::Graph<T, I>& graph, T (* mf_algorithm) (ds::Graph<T, I>& graph)) {
     std::chrono::steady_clock::time_point start;
     std::chrono::steady_clock::time_point end;
 
@@ -88,8 +135,24 @@ auto benchmark(ds::Graph<T>& graph, T (* mf_algorithm) (ds::Graph<T>& graph)) {
     return std::pair{elapsed_time, max_flow};
 }
 
+/**
+ * @brief Times algorithms::solve with features computed once before all runs.
+ * 
+ * @return auto pair of (elapsed_time [ms], result of solve with the engine it chose)
+ */
+template <typename T, typename I>
+auto benchmark_solve(ds::Graph<T, I>& graph, const algorithms::GraphFeatures<T>& features) {
+    auto start{std::chrono::steady_clock::now()};
+    auto result{algorithms::solve(graph, features)};
+    auto end{std::chrono::steady_clock::now()};
+
+    std::chrono::microseconds::rep elapsed_time{std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()};
+    return std::pair{elapsed_time, result};
+}
+
 template <typename T>
-void printResult(T result_max_flow, auto result_time, std::string_view algorithm_used, int num_of_runs) {
+void printResult(T result_max_flow, auto result_time, std::string_view algorithm_used, int num_of_runs, 
+        std::string_view certificate_error) {
     using namespace counters;
     std::cout << "\n--------------------------------------------------------\n\n";
     std::cout << algorithm_used << ":\n";
@@ -98,7 +161,12 @@ void printResult(T result_max_flow, auto result_time, std::string_view algorithm
     std::string relabels{};
     if(algorithm_used == "FORD-FULKERSON DFS") {edges_visited = std::to_string(ff_edges_visited*1.0/num_of_runs);}
     else if(algorithm_used == "EDMONDS-KARP") {edges_visited = std::to_string(ek_edges_visited*1.0/num_of_runs);}
+    else if(algorithm_used == "EDMONDS-KARP BIDIRECTIONAL") {edges_visited = std::to_string(ek_edges_visited*1.0/num_of_runs);}
     else if(algorithm_used == "DINIC'S") {edges_visited = std::to_string(dinic_edges_visited*1.0/num_of_runs);}
+    // the bfs is shared with dinic's and counted there
+    else if(algorithm_used == "DINIC'S + DYNAMIC TREES") {
+        edges_visited = std::to_string((dinic_edges_visited + dinic_dt_edges_visited)*1.0/num_of_runs);
+    }
     else if(algorithm_used == "PUSH-RELABEL") {
         pushes = std::to_string(pr_pushes*1.0/num_of_runs);
         relabels = std::to_string(pr_relabels*1.0/num_of_runs);
@@ -115,6 +183,11 @@ void printResult(T result_max_flow, auto result_time, std::string_view algorithm
     }
     std::cout << "Max flow: " << result_max_flow << " in an average of " << result_time*1.0/num_of_runs << 
         " ms over " << num_of_runs << " run" << ((num_of_runs > 1)?"s.\n" : ".\n");
+    if(certificate_error.empty()) {
+        std::cout << "Certificate: verified (flow value equals the capacity of a cut)\n";
+    } else {
+        std::cout << "Certificate: FAILED, " << certificate_error << "\n";
+    }
 }
 
 #endif
\ No newline at end of file
@@ -6,13 +6,62 @@
 #include <string_view>
 
 namespace io {
+
+    /**
+     * @brief The "p" line of a dimacs file.
+     */
+    struct DimacsHeader {
+        long long n{0};
+        long long m{0};
+    };
+
+    /**
+     * @brief Reads only the problem line of a dimacs file, e.g. to decide
+     *        which index type the graph needs (see ds::fits_index).
+     * 
+     * @param path path to the dimacs file.
+     * @return DimacsHeader Number of vertices and arcs.
+     */
+    DimacsHeader read_header(std::string_view path);
+
     /**
      * @brief Reads a graph in dimacs format.
      * 
+     *        Besides "a u v c" arcs, "e u v c" lines are read as undirected edges with
+     *        capacity c in both directions and "v u c" lines limit the flow through u to c.
+     *        Several "n u s" ("n u t") lines give several sources (sinks).
+     *        The file is read twice, arcs go straight into the graph and are never held
+     *        in a separate list. Exits on a vertex id out of range.
+     * 
+     *        Instantiated for <int, int>, <long long, int> and <long long, long long>.
+     * 
+     * @tparam T Flow type. (pynetgen generates only ints)
+     * @tparam I Index type, the graph needs to fit (see ds::fits_index).
      * @param path path to the dimacs file.
-     * @return ds::Graph<int> The graph as a residual network. (pynetgen generates only ints)
+     * @param options Where to keep the edges and adjacency lists (RAM or memory-mapped files).
+     * @return ds::Graph<T, I> The graph as a residual network.
+     */
+    template <typename T = int, typename I = int>
+    ds::Graph<T, I> load_graph_from_file(std::string_view path, ds::StorageOptions options = {});
+
+    /**
+     * @brief Reads a binary snapshot written by generators::write_binary.
+     * 
+     *        Exits on a truncated file, a header that does not match the file size
+     *        or a vertex id out of range. Arcs are read in blocks (twice), so only
+     *        the graph itself needs to fit in memory (or the backing files).
+     * 
+     *        Instantiated for <int, int>, <long long, int> and <long long, long long>.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type, the graph needs to fit (see ds::fits_index).
+     * @param path path to the snapshot.
+     * @param num_threads Number of threads used to build the residual network (0 = all hardware threads).
+     * @param options Where to keep the edges and adjacency lists (RAM or memory-mapped files).
+     * @return ds::Graph<T, I> The graph as a residual network.
      */
-    ds::Graph<int> load_graph_from_file(std::string_view path);
+    template <typename T = int, typename I = int>
+    ds::Graph<T, I> load_graph_from_binary(std::string_view path, unsigned num_threads=0, ds::StorageOptions options = {});
 
 }
 
@@ -8,8 +8,11 @@
 // translated to C++ and to be able to write to files
 
 #include "../generators/ak/ak.h"
+#include "../generators/network.h"
+#include "../algorithms/parallel.h"
 #include <iostream>
 #include <fstream>
+#include <string>
 
 
 namespace generators {
@@ -60,5 +63,80 @@ namespace generators {
             file << "a "+to_string(4*n+6)+" 2 1000000";
             file.close();
         }
+    
+        /**
+         * @brief The k-th arc written by generate, vertices 1-indexed.
+         *        Every arc only depends on k, so the arcs can be built in any order.
+         * 
+         * @param n The parameter needed to generate the network.
+         * @param k Index of the arc, 0 <= k < 6n+7.
+         * @return ds::Graph<int>::Arc The arc.
+         */
+        ds::Graph<int>::Arc arc_at(int n, int k) {
+            int d{2*n+4};
+            // first horrible graph
+            if(k < 2*n) {
+                int i{k/2};
+                return (k%2 == 0) ? ds::Graph<int>::Arc{i+3, i+4, n-i+1} : ds::Graph<int>::Arc{i+3, n+4, 1};
+            }
+            if(k == 2*n) { return {n+3, 2*n+4, 1}; }
+            if(k == 2*n+1) { return {n+3, n+4, 1}; }
+            // second horrible graph
+            if(k < 3*n+2) {
+                int i{k-(2*n+2)+n+3};
+                return {i+1, i+2, n+1};
+            }
+            if(k < 5*n+3) {
+                int i{k-(3*n+2)+d};
+                return {i+1, i+2, n};
+            }
+            if(k < 6*n+3) {
+                int i{k-(5*n+3)};
+                return {i+d+1, 2*n+2-i+d, 1};
+            }
+            // edges from source to sink
+            switch(k-(6*n+3)) {
+                case 0: return {1, 3, 1000000};
+                case 1: return {1, d+1, 1000000};
+                case 2: return {d, 2, 1000000};
+                default: return {4*n+6, 2, 1000000};
+            }
+        }
+
+        /**
+         * @brief Generates the ak max flow problem in memory, the arcs of
+         *        each part of the network are written in parallel.
+         * 
+         * @param n The parameter needed to generate the network.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @return Network The generated problem.
+         */
+        Network generate_network(int n, unsigned num_threads) {
+            Network network{};
+            if(n < 2) { return network; }
+            network.n = 4*n+6;
+            network.s = 0;
+            network.t = 1;
+            network.comments.push_back("very bad maxflow problem");
+            network.arcs.resize(6*n+7);
+            algorithms::utils::parallel_for(0, network.arcs.size(), num_threads, [&](unsigned, std::size_t begin, std::size_t end) {
+                for(std::size_t k{begin}; k < end; ++k) {
+                    auto arc{arc_at(n, static_cast<int>(k))};
+                    network.arcs[k] = {arc.tail-1, arc.head-1, arc.capacity};
+                }
+            });
+            return network;
+        }
+
+        /**
+         * @brief Generates the ak max flow problem directly as a residual network.
+         * 
+         * @param n The parameter needed to generate the network.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @return ds::Graph<int> The residual network.
+         */
+        ds::Graph<int> generate_graph(int n, unsigned num_threads) {
+            return to_graph(generate_network(n, num_threads), num_threads);
+        }
     }
 }
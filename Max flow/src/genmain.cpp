@@ -4,6 +4,8 @@
 // translated to C++ and changed a few things to integrate the generator into my project
 
 #include "../generators/genrmf/gen_maxflow_typedef.h"
+#include "../generators/genrmf/genrmf.h"
+#include "../generators/network.h"
 #include "../algorithms/random.h"
 
 #include <iostream>
@@ -18,6 +20,7 @@ namespace generators {
 		void gen_free_net(network * n);
 		void print_max_format (std::ofstream& path, network * n, int dim);
 		network * gen_rmf(int a, int b, int c1, int c2, algorithms::utils::Random& rand);
+		Network gen_rmf_network(int a, int b, int c1, int c2, unsigned int seed, unsigned num_threads);
 
 
 		/**
@@ -59,6 +62,42 @@ namespace generators {
 
 			file.close();
 		}
+
+		/**
+         * @brief Generate a genrmf max flow problem in memory. The frames are generated
+         *        in parallel, each frame using its own random stream derived from the seed.
+         * 
+         * @param a Frame size.
+         * @param b Depth.
+         * @param c1 min capacity.
+         * @param c2 max capacity.
+         * @param seed Seed for the random capacities.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @return Network The generated problem.
+         */
+		Network generate_network(int a, int b, int c1, int c2, int seed, unsigned num_threads) {
+			using std::to_string;
+			unsigned int s = (seed <= -1) ? algorithms::utils::Random().get_seed() : seed;
+			Network n = gen_rmf_network(a, b, c1, c2, s, num_threads);
+			n.comments.push_back("This file was generated by genrmf.");
+			n.comments.push_back("params: a: " + to_string(a) + " b: " + to_string(b) + " c1: " + to_string(c1) 
+				+ " c2: " + to_string(c2) + " seed: " + to_string(s) + " (frame streams)");
+			return n;
+		}
+
+		/**
+         * @brief Generate a genrmf max flow problem directly as a residual network.
+         * 
+         * @param a Frame size.
+         * @param b Depth.
+         * @param c1 min capacity.
+         * @param c2 max capacity.
+         * @param seed Seed for the random capacities.
+         * @param num_threads Number of threads to use (0 = all hardware threads).
+         * @return ds::Graph<int> The residual network.
+         */
+		ds::Graph<int> generate_graph(int a, int b, int c1, int c2, int seed, unsigned num_threads) {
+			return to_graph(generate_network(a, b, c1, c2, seed, num_threads), num_threads);
+		}
 	}
 }
-
@@ -67,7 +67,9 @@ ZOR - Methods & Models of OR (1989) 33:383-403
 // translated to C++ and changed a few things to integrate the generator into my project
 
 #include "../generators/genrmf/gen_maxflow_typedef.h"
+#include "../generators/network.h"
 #include "../algorithms/random.h"
+#include "../algorithms/parallel.h"
 
 #include <vector>
 #include <iostream>
@@ -157,7 +159,55 @@ namespace generators {
 			}
 			return N;
 		}		
+	
+		/*==================================================================*/
+		/* same network as gen_rmf, 0-indexed and built in memory. Frames are
+		   independent: frame z uses the random stream (seed, z) and writes its
+		   arcs at a fixed offset, so frames are generated in parallel. */
+		Network gen_rmf_network(int a, int b, int c1, int c2, unsigned int seed, unsigned num_threads) {
+			int A = a;
+			int AA = a*a;
+			int C2AA = c2*AA;
+			// arcs of every frame but the last one (intermediate + in-frame edges)
+			int frame_edges = 5*AA-4*A;
+
+			Network N{};
+			N.n = AA * b;
+			N.s = 0;
+			N.t = N.n-1;
+			N.arcs.resize(5*AA*b-4*A*b-AA);
+
+			algorithms::utils::parallel_for(1, b+1, num_threads, [&](unsigned, std::size_t begin, std::size_t end) {
+				std::vector<int> Parr(AA+1);
+				for(int z = static_cast<int>(begin); z < static_cast<int>(end); z++) {
+					algorithms::utils::Random rand(seed, z);
+					int offset = AA * (z-1);
+					int Ec = (z-1) * frame_edges;
+					auto add = [&](int from, int to, int cap) {
+						N.arcs[Ec++] = {from-1, to-1, cap};
+					};
+					for (int x = 1; x <= AA; x++) {
+						Parr[x] = x;
+					}
+					if (z != b) {
+						permute(AA, Parr, rand);
+					}
+					for(int x = 1; x <= A; x++){ 
+						for(int y = 1; y <= A; y++){
+							int cv = offset + (x - 1) * A + y;
+							if (z != b) {
+								/* the intermediate edges */
+								add(cv, offset + AA + Parr[cv - offset], rand.random_num_in_range(c1, c2));
+							}
+							if (y < A) add(cv, offset + (x - 1) * A + y + 1, C2AA);
+							if (y > 1) add(cv, offset + (x - 1) * A + y - 1, C2AA);
+							if (x < A) add(cv, offset + x * A + y, C2AA);
+							if (x > 1) add(cv, offset + (x - 2) * A + y, C2AA);
+						}
+					}
+				}
+			});
+			return N;
+		}
 	}
 }
-
-
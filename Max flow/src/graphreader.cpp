@@ -2,22 +2,84 @@
 #include "../io/graphreader.h"
 
 #include <string>
+#include <stdexcept>
 #include <string_view>
 #include <fstream>
 #include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <utility>
 
 
 namespace io {
-//
+
+    // exits if the value does not fit into the type used by the graph
+    template <typename V>
+    V checked(long long value, std::string_view what) {
+        if(value > std::numeric_limits<V>::max() || value < std::numeric_limits<V>::min()) {
+            std::cout << "Error: " << what << " " << value << " does not fit the chosen type.";
+            std::exit(1);
+        }
+        return static_cast<V>(value);
+    }
+
+    // exits if the value is not the id of one of the n vertices
+    template <typename I>
+    I checked_vertex(long long value, long long n) {
+        if(value < 0 || value >= n) {
+            std::cout << "Error: vertex " << value+1 << " out of range (" << n << " vertices).";
+            std::exit(1);
+        }
+        return static_cast<I>(value);
+    }
+
+    // exits if the file ended early or could not be read
+    void check_read(const std::istream& file) {
+        if(!file) {
+            std::cout << "Error: file truncated or unreadable.";
+            std::exit(1);
+        }
+    }
+
+    /**
+     * @brief Reads only the problem line of a dimacs file, e.g. to decide
+     *        which index type the graph needs (see ds::fits_index).
+     * 
+     * @param path path to the dimacs file.
+     * @return DimacsHeader Number of vertices and arcs.
+     */
+    DimacsHeader read_header(std::string_view path) {
+        std::ifstream file{std::string{path}};
+        std::string line{};
+        if(!file.is_open()) {
+            std::cout << "Error opening file.";
+            std::exit(1);
+        }
+        // skip comments
+        while(getline(file, line) && line[0] == 'c') {}
+        std::stringstream n_line(line);
+        std::string skip{};
+        DimacsHeader header{};
+        n_line >> skip >> skip; // skip "p" and problem definition "max"
+        n_line >> header.n >> header.m;
+        return header;
+    }
+
     /**
      * @brief Reads a graph in dimacs format.
      * 
+     * @tparam T Flow type. (pynetgen generates only ints)
+     * @tparam I Index type, the graph needs to fit (see ds::fits_index).
      * @param path path to the dimacs file.
-     * @return ds::Graph<int> The graph as a residual network. (pynetgen generates only ints)
+     * @param options Where to keep the edges (RAM or memory-mapped files).
+     * @return ds::Graph<T, I> The graph as a residual network.
      */
-    ds::Graph<int> load_graph_from_file(std::string_view path) {
+    template <typename T, typename I>
+    ds::Graph<T, I> load_graph_from_file(std::string_view path, ds::StorageOptions options) {
         std::cout << "\nLoading graph " << path << "\n";
-        std::ifstream file(path);
+        std::ifstream file{std::string{path}};
         std::string line{};
         if(!file.is_open()) {
             std::cout << "Error opening file.";
@@ -32,33 +94,188 @@ namespace io {
         n_line >> n; // skin problem definition "max" for maximum flow
         n_line >> n; // number of vertices
         std::cout << "Graph with " << n << " vertices and ";
-        ds::Graph<int> g{std::stoi(n)};
+        long long num_vertices{std::stoll(n)};
         n_line >> n; // number of edges
         std::cout << n << " edges.\n";
-        // read source and sink
-        getline(file, line);
-        std::stringstream s_line(line);
-        std::string s{};
-        s_line >> s; // skip "n"
-        s_line >> s;  // source
-        g.m_s = std::stoi(s)-1;
-        getline(file, line);
-        std::stringstream t_line(line);
-        std::string t{0};
-        t_line >> t; // skip "n"
-        t_line >> t; // sink
-        g.m_t = std::stoi(t)-1;
-        // read edges
+        long long num_edges{std::stoll(n)};
+        if(!ds::fits_index<I>(num_vertices, num_edges)) {
+            std::cout << "Error: graph too large for the chosen index type.";
+            std::exit(1);
+        }
+        ds::Graph<T, I> g{static_cast<I>(num_vertices), std::move(options)};
+        // first pass: terminals, vertex capacities and the degrees, arcs are only counted
+        // so that they can be streamed into the graph in the second pass (no copy of all arcs)
+        std::vector<I> out_degree(num_vertices, 0);
+        std::vector<I> in_degree(num_vertices, 0);
+        std::vector<I> undirected_degree(num_vertices, 0);
+        // several "n" lines of a kind make a multi-source / multi-sink network
+        std::vector<I> sources{};
+        std::vector<I> sinks{};
+        // applied once the terminals are known, a sink can't have a capacity
+        std::vector<std::pair<I, T>> vertex_capacities{};
+        std::streampos arcs_begin{file.tellg()};
+        while(getline(file, line)) {
+            std::stringstream edge_line(line);
+            std::string type{};
+            edge_line >> type;
+            if(type == "n") {
+                std::string v{};
+                std::string which{};
+                edge_line >> v >> which;
+                (which == "s" ? sources : sinks).push_back(checked_vertex<I>(std::stoll(v)-1, num_vertices));
+            } else if(type == "a" || type == "e") {
+                std::string in_v{};
+                std::string out_v{};
+                edge_line >> in_v >> out_v; // read tail and head
+                I tail{checked_vertex<I>(std::stoll(in_v)-1, num_vertices)};
+                I head{checked_vertex<I>(std::stoll(out_v)-1, num_vertices)};
+                if(type == "e") {
+                    ++undirected_degree[tail];
+                    ++undirected_degree[head];
+                } else {
+                    ++out_degree[tail];
+                    ++in_degree[head];
+                }
+            } else if(type == "v") {
+                std::string v{};
+                std::string cap{};
+                edge_line >> v >> cap;
+                vertex_capacities.emplace_back(checked_vertex<I>(std::stoll(v)-1, num_vertices), checked<T>(std::stoll(cap), "capacity"));
+            }
+        }
+        // the first sink replaces the default one, so only sources that are given sinks collide
+        if(!sinks.empty()) { g.m_t = sinks.front(); }
+        try {
+            if(!sources.empty()) { g.set_sources(sources); }
+            if(!sinks.empty()) { g.set_sinks(sinks); }
+            for(auto [vertex, capacity] : vertex_capacities) {
+                g.set_vertex_capacity(vertex, capacity);
+            }
+        } catch(const std::invalid_argument& error) {
+            std::cout << "Error: " << error.what() << ".";
+            std::exit(1);
+        }
+        // a split vertex keeps the incoming edges, its second half the outgoing ones (+ the inner edge each)
+        for(I v{0}; v < static_cast<I>(num_vertices); ++v) {
+            if(g.out(v) != v) {
+                g.reserve_edges(v, in_degree[v] + undirected_degree[v] + 1);
+                g.reserve_edges(g.out(v), out_degree[v] + undirected_degree[v] + 1);
+            } else {
+                g.reserve_edges(v, out_degree[v] + in_degree[v] + undirected_degree[v]);
+            }
+        }
+        std::vector<I>{}.swap(out_degree);
+        std::vector<I>{}.swap(in_degree);
+        std::vector<I>{}.swap(undirected_degree);
+
+        // second pass: the edges, vertex capacities are known now
+        file.clear();
+        file.seekg(arcs_begin);
         while(getline(file, line)) {
             std::stringstream edge_line(line);
-            std::string in_v{};
-            std::string out_v{};
-            std::string cap{};
-            edge_line >> in_v; // skip "a"
-            edge_line >> in_v >> out_v >> cap; // read tail, head and capacity
-            g.add_edge(std::stoi(in_v)-1, std::stoi(out_v)-1, std::stoi(cap));
+            std::string type{};
+            edge_line >> type;
+            if(type == "a" || type == "e") {
+                std::string in_v{};
+                std::string out_v{};
+                std::string cap{};
+                edge_line >> in_v >> out_v >> cap; // read tail, head and capacity
+                I tail{static_cast<I>(std::stoll(in_v)-1)};
+                I head{static_cast<I>(std::stoll(out_v)-1)};
+                T capacity{checked<T>(std::stoll(cap), "capacity")};
+                if(type == "e") {
+                    g.add_undirected_edge(tail, head, capacity);
+                } else {
+                    g.add_edge(tail, head, capacity);
+                }
+            }
+        }
+        file.close();
+        return g;
+    }
+
+    /**
+     * @brief Reads a binary snapshot written by generators::write_binary.
+     * 
+     * @tparam T Flow type.
+     * @tparam I Index type, the graph needs to fit (see ds::fits_index).
+     * @param path path to the snapshot.
+     * @param num_threads Number of threads used to build the residual network (0 = all hardware threads).
+     * @param options Where to keep the edges (RAM or memory-mapped files).
+     * @return ds::Graph<T, I> The graph as a residual network.
+     */
+    template <typename T, typename I>
+    ds::Graph<T, I> load_graph_from_binary(std::string_view path, unsigned num_threads, ds::StorageOptions options) {
+        std::cout << "\nLoading graph " << path << "\n";
+        std::ifstream file{std::string{path}, std::ios::binary};
+        char magic[8]{};
+        if(!file.is_open() || !file.read(magic, 8) || std::memcmp(magic, "MFGRAPH1", 8) != 0) {
+            std::cout << "Error opening file.";
+            std::exit(1);
+        }
+        std::int64_t header[4]{}; // n, m, s, t
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        check_read(file);
+        std::cout << "Graph with " << header[0] << " vertices and " << header[1] << " edges.\n";
+        // magic, header and 3 values per arc, nothing else
+        file.seekg(0, std::ios::end);
+        long long file_size{static_cast<long long>(file.tellg())};
+        file.seekg(sizeof(magic) + sizeof(header));
+        long long arc_bytes{file_size - static_cast<long long>(sizeof(magic) + sizeof(header))};
+        if(header[0] <= 0 || header[1] < 0 || header[1] != arc_bytes / (3*static_cast<long long>(sizeof(std::int64_t)))
+                || arc_bytes % (3*sizeof(std::int64_t)) != 0) {
+            std::cout << "Error: header does not match the file size.";
+            std::exit(1);
+        }
+        if(!ds::fits_index<I>(header[0], header[1])) {
+            std::cout << "Error: graph too large for the chosen index type.";
+            std::exit(1);
+        }
+        ds::Graph<T, I> g{static_cast<I>(header[0]), std::move(options)};
+        g.m_s = checked_vertex<I>(header[2], header[0]);
+        g.m_t = checked_vertex<I>(header[3], header[0]);
+        // arcs are read in blocks, never all at once: first pass for the degrees,
+        // second pass streams the arcs into the graph
+        static constexpr std::size_t block_arcs{1 << 20};
+        std::vector<std::int64_t> raw{};
+        auto read_block = [&file, &raw, &header](std::size_t first) {
+            std::size_t count{std::min<std::size_t>(block_arcs, header[1] - first)};
+            raw.resize(3*count);
+            file.read(reinterpret_cast<char*>(raw.data()), raw.size()*sizeof(std::int64_t));
+            check_read(file);
+            return count;
+        };
+        std::vector<I> degree(header[0], 0);
+        for(std::size_t first{0}; first < static_cast<std::size_t>(header[1]); first += block_arcs) {
+            std::size_t count{read_block(first)};
+            for(std::size_t i{0}; i < count; ++i) {
+                ++degree[checked_vertex<I>(raw[3*i], header[0])];
+                ++degree[checked_vertex<I>(raw[3*i+1], header[0])];
+            }
+        }
+        for(I v{0}; v < static_cast<I>(header[0]); ++v) {
+            g.reserve_edges(v, degree[v]);
+        }
+        std::vector<I>{}.swap(degree);
+
+        file.seekg(sizeof(magic) + sizeof(header));
+        std::vector<typename ds::Graph<T, I>::Arc> arcs{};
+        for(std::size_t first{0}; first < static_cast<std::size_t>(header[1]); first += block_arcs) {
+            std::size_t count{read_block(first)};
+            arcs.resize(count);
+            for(std::size_t i{0}; i < count; ++i) {
+                arcs[i] = {static_cast<I>(raw[3*i]), static_cast<I>(raw[3*i+1]), checked<T>(raw[3*i+2], "capacity")};
+            }
+            g.add_edges(arcs, num_threads);
         }
         file.close();
         return g;
     }
+
+    template ds::Graph<int, int> load_graph_from_file(std::string_view, ds::StorageOptions);
+    template ds::Graph<long long, int> load_graph_from_file(std::string_view, ds::StorageOptions);
+    template ds::Graph<long long, long long> load_graph_from_file(std::string_view, ds::StorageOptions);
+    template ds::Graph<int, int> load_graph_from_binary(std::string_view, unsigned, ds::StorageOptions);
+    template ds::Graph<long long, int> load_graph_from_binary(std::string_view, unsigned, ds::StorageOptions);
+    template ds::Graph<long long, long long> load_graph_from_binary(std::string_view, unsigned, ds::StorageOptions);
 }
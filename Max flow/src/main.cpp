@@ -10,23 +10,46 @@
 #include <chrono>
 #include <filesystem>
 
-int main() {
-
-	// generate using genrmf and a = 10, b = 20, c1 = 1, c2 = 1000 and seed = 1
-    generators::genrmf::generate(10, 20, 1, 1000, 1);
-	// generate using ak and n = 2000
-    generators::ak::generate(2000);
+/**
+ * @brief Benchmarks a .dimacs file, using 32-bit indices where the graph 
+ *        fits and 64-bit indices otherwise.
+ * 
+ * @param path path to the dimacs file.
+ */
+void benchmark_file(const std::string& path) {
+	io::DimacsHeader header{io::read_header(path)};
+	if(ds::fits_index<int>(header.n, header.m)) {
+		ds::Graph<long long, int> g{io::load_graph_from_file<long long, int>(path)};
+		start<long long>(g);
+	} else {
+		// huge graph, keep the edges in memory-mapped files next to the input
+		ds::StorageOptions options{std::filesystem::path(path).parent_path().string(), true};
+		if(options.backing_directory.empty()) { options.backing_directory = "."; }
+		ds::Graph<long long, long long> g{io::load_graph_from_file<long long, long long>(path, options)};
+		start<long long>(g);
+	}
+}
 
-    std::vector<std::string> paths = {"test graphs/ak/",
-                                       "test graphs/genrmf/"};
+int main(int argc, char* argv[]) {
 
-	// test each algorithm on the generated graphs
-    for(auto& path : paths) {
-		for(auto& file : std::filesystem::directory_iterator(path)) {
-			ds::Graph<int> g{io::load_graph_from_file(file.path().string())};
-			start<int>(g);
+	// benchmark the given .dimacs files
+	if(argc > 1) {
+		for(int i{1}; i < argc; ++i) {
+			benchmark_file(argv[i]);
 		}
+		return 0;
 	}
 
+	// generate in memory using genrmf and a = 10, b = 20, c1 = 1, c2 = 1000 and seed = 1
+	// (generators::write_dimacs / write_binary on generate_network to keep a copy on disk)
+	std::cout << "\nGenerating genrmf a = 10, b = 20, c1 = 1, c2 = 1000, seed = 1\n";
+	ds::Graph<int> rmf{generators::genrmf::generate_graph(10, 20, 1, 1000, 1)};
+	start<int>(rmf);
+
+	// generate in memory using ak and n = 2000
+	std::cout << "\nGenerating ak n = 2000\n";
+	ds::Graph<int> ak{generators::ak::generate_graph(2000)};
+	start<int>(ak);
+
     return 0;
 }
@@ -0,0 +1,88 @@
+#include "../generators/network.h"
+#include "../data structures/graph.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace generators {
+
+    /**
+     * @brief Builds the residual network of a generated problem.
+     * 
+     * @param network The generated problem.
+     * @param num_threads Number of threads to use (0 = all hardware threads).
+     * @return ds::Graph<int> The residual network.
+     */
+    ds::Graph<int> to_graph(const Network& network, unsigned num_threads) {
+        ds::Graph<int> g{network.n};
+        g.m_s = network.s;
+        g.m_t = network.t;
+        g.add_edges(network.arcs, num_threads);
+        return g;
+    }
+
+    /**
+     * @brief Writes the problem in .dimacs format.
+     * 
+     * @param network The generated problem.
+     * @param path Where to save the file.
+     */
+    void write_dimacs(const Network& network, std::string_view path) {
+        std::ofstream file{std::string{path}};
+        if(!file.is_open()) {
+            std::cout << "Error opening file " << path << ".\n";
+            return;
+        }
+        for(const auto& comment : network.comments) {
+            file << "c " << comment << "\n";
+        }
+        file << "p max " << network.n << " " << network.arcs.size() << "\n";
+        file << "n " << network.s+1 << " s\n";
+        file << "n " << network.t+1 << " t\n";
+        for(const auto& arc : network.arcs) {
+            file << (arc.undirected ? "e " : "a ") << arc.tail+1 << " " << arc.head+1 << " " << arc.capacity << "\n";
+        }
+        file.close();
+    }
+
+    /**
+     * @brief Writes the problem as a binary snapshot, readable with io::load_graph_from_binary.
+     * 
+     * @param network The generated problem.
+     * @param path Where to save the file.
+     */
+    void write_binary(const Network& network, std::string_view path) {
+        std::ofstream file{std::string{path}, std::ios::binary};
+        if(!file.is_open()) {
+            std::cout << "Error opening file " << path << ".\n";
+            return;
+        }
+        auto write = [&file](std::int64_t value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        // the snapshot only knows directed arcs, undirected edges are written as two arcs
+        std::int64_t m{0};
+        for(const auto& arc : network.arcs) {
+            m += arc.undirected ? 2 : 1;
+        }
+        file.write("MFGRAPH1", 8);
+        write(network.n);
+        write(m);
+        write(network.s);
+        write(network.t);
+        for(const auto& arc : network.arcs) {
+            write(arc.tail);
+            write(arc.head);
+            write(arc.capacity);
+            if(arc.undirected) {
+                write(arc.head);
+                write(arc.tail);
+                write(arc.capacity);
+            }
+        }
+        file.close();
+    }
+}
@@ -10,6 +10,12 @@ namespace algorithms {
             : m_generator(seed)
             , m_seed{seed} {}
 
+        Random::Random(unsigned int seed, unsigned int stream) 
+            : m_seed{seed} {
+            std::seed_seq sequence{seed, stream};
+            m_generator.seed(sequence);
+        }
+
         Random::Random() {
             std::random_device rd;
             m_seed = rd();
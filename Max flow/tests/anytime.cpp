@@ -0,0 +1,62 @@
+#include "../data structures/graph.h"
+#include "../algorithms/solve.h"
+#include "../generators/genrmf/genrmf.h"
+#include "check.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string>
+
+/**
+ * The anytime overloads have to return close to the deadline, and the upper
+ * bound has to hold even when cuts have more capacity than the flow type holds.
+ */
+
+using tests::check;
+
+int main() {
+    using namespace std::chrono_literals;
+    // cuts of 2^33 before the one of the sink edge
+    {
+        ds::Graph<int> graph{tests::funnel(8, 1 << 30, 1)};
+        check(algorithms::residual_cut_bound(graph) == 1, "cut bound with cuts larger than int");
+    }
+    {
+        constexpr int max{std::numeric_limits<int>::max()};
+        ds::Graph<int> graph{tests::funnel(4, 1 << 30, max)};
+        check(algorithms::residual_cut_bound(graph) == max, "cut bound up to the largest int");
+        algorithms::SolveOptions<int> options{};
+        options.deadline = std::chrono::steady_clock::now();
+        auto result{algorithms::edmonds_karp(graph, options)};
+        check(result.upper_bound >= result.flow, "upper bound at least the flow");
+    }
+
+    // the searches check the deadline every few vertices, after it only the upper bound
+    // is computed (a bfs over the network), timed here on the untouched network
+    ds::Graph<int> graph{generators::genrmf::generate_graph(60, 60, 1, 10000, 1)};
+    constexpr auto deadline{50ms};
+    auto bound_time{std::chrono::steady_clock::duration::max()};
+    for(int run{0}; run < 3; ++run) {
+        auto start{std::chrono::steady_clock::now()};
+        algorithms::residual_cut_bound(graph);
+        bound_time = std::min(bound_time, std::chrono::steady_clock::now() - start);
+    }
+    auto slack{2*bound_time + 20ms};
+    for(auto engine : {algorithms::Engine::ford_fulkerson, algorithms::Engine::edmonds_karp,
+            algorithms::Engine::edmonds_karp_bidirectional, algorithms::Engine::dinic,
+            algorithms::Engine::dinic_dynamic_trees, algorithms::Engine::push_relabel,
+            algorithms::Engine::hi_push_relabel}) {
+        graph.restore();
+        algorithms::SolveOptions<int> options{};
+        auto start{std::chrono::steady_clock::now()};
+        options.deadline = start + deadline;
+        auto result{algorithms::run_engine(graph, engine, options)};
+        auto elapsed{std::chrono::steady_clock::now() - start};
+        auto ms{std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()};
+        std::string name{algorithms::engine_name(engine)};
+        check(elapsed < deadline + slack, name + " returned " + std::to_string(ms) + " ms after the start");
+        check(result.upper_bound >= result.flow, name + " upper bound at least the flow");
+    }
+    return tests::report("anytime");
+}
@@ -0,0 +1,72 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include "../data structures/graph.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+/**
+ * Shared by the tests: every test is a program counting its failed checks,
+ * plus the small networks several tests build.
+ */
+namespace tests {
+
+    inline int failures{0};
+
+    /**
+     * @brief Prints what failed unless the condition holds.
+     */
+    inline void check(bool condition, const std::string& what) {
+        if(!condition) {
+            std::cout << "FAILED: " << what << "\n";
+            ++failures;
+        }
+    }
+
+    /**
+     * @brief Prints "name: ok" if no check failed.
+     * 
+     * @return int The exit code of the test.
+     */
+    inline int report(std::string_view name) {
+        if(failures == 0) { std::cout << name << ": ok\n"; }
+        return failures == 0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Source 0, vertex 1 with the given vertex capacity, 8 paths 1 -> k -> 10 (sink)
+     *        of capacity 100.
+     */
+    inline ds::Graph<int> diamond(int vertex_capacity) {
+        ds::Graph<int> graph{11};
+        graph.m_s = 0;
+        graph.m_t = 10;
+        graph.set_vertex_capacity(1, vertex_capacity);
+        graph.add_edge(0, 1, 100);
+        for(int k{2}; k < 10; ++k) {
+            graph.add_edge(1, k, 100);
+            graph.add_edge(k, 10, 100);
+        }
+        return graph;
+    }
+
+    /**
+     * @brief Source 0, `width` edges of the given capacity to vertices 1..width, from each of
+     *        them the same capacity to width+1 which has an edge with capacity last to the sink.
+     */
+    inline ds::Graph<int> funnel(int width, int capacity, int last) {
+        ds::Graph<int> graph{width+3};
+        graph.m_s = 0;
+        graph.m_t = width+2;
+        for(int k{1}; k <= width; ++k) {
+            graph.add_edge(0, k, capacity);
+            graph.add_edge(k, width+1, capacity);
+        }
+        graph.add_edge(width+1, width+2, last);
+        return graph;
+    }
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "../data structures/graph.h"
+#include "../algorithms/kernels.h"
+#include "check.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * The vectorized kernels have to return exactly what the plain loops return, for
+ * every instruction set the cpu supports (the others are skipped) and both
+ * vectorized flow types.
+ */
+
+using tests::check;
+using algorithms::kernels::SimdLevel;
+
+namespace {
+
+    /**
+     * @brief Runs both kernels on every vertex at the given level and compares them
+     *        with the scalar level. Degrees 0 to 99 cover every leftover of the lanes.
+     */
+    template <typename T>
+    void compare(SimdLevel level, const std::string& name) {
+        namespace kernels = algorithms::kernels;
+        constexpr int n{100};
+        std::mt19937 rng{7};
+        ds::Graph<T> graph{n};
+        for(int v{0}; v < n; ++v) {
+            for(int k{0}; k < v; ++k) {
+                // a third of the edges without residual capacity, some negative
+                T capacity{static_cast<T>(static_cast<int>(rng() % 3) - 1) * static_cast<T>(rng() % 1000)};
+                graph.add_edge(v, static_cast<int>(rng() % n), capacity);
+            }
+        }
+        std::vector<int> labels(n);
+        std::vector<unsigned int> stamps(n);
+        for(int v{0}; v < n; ++v) {
+            // ties on purpose, the first edge with the minimal label has to win
+            labels[v] = static_cast<int>(rng() % 20);
+            stamps[v] = rng() % 3;
+        }
+        SimdLevel previous{kernels::max_simd_level};
+        std::vector<int> expected(n);
+        std::vector<int> found(n);
+        for(int v{0}; v < n; ++v) {
+            auto edges{graph.m_adj_list[v]};
+            kernels::max_simd_level = SimdLevel::scalar;
+            auto scalar_label{kernels::min_residual_label(edges.data(), edges.size(), labels.data())};
+            std::size_t scalar_count{kernels::collect_unreached(edges.data(), edges.size(), stamps.data(), 1u, expected.data())};
+            kernels::max_simd_level = level;
+            auto label{kernels::min_residual_label(edges.data(), edges.size(), labels.data())};
+            std::size_t count{kernels::collect_unreached(edges.data(), edges.size(), stamps.data(), 1u, found.data())};
+            std::string where{name + ", vertex " + std::to_string(v)};
+            check(label == scalar_label, "min_residual_label differs, " + where);
+            check(count == scalar_count && std::equal(found.begin(), found.begin() + count, expected.begin()),
+                "collect_unreached differs, " + where);
+        }
+        kernels::max_simd_level = previous;
+    }
+}
+
+int main() {
+    SimdLevel detected{algorithms::kernels::detect_simd_level()};
+    for(auto [level, name] : {std::pair{SimdLevel::avx2, "avx2"}, std::pair{SimdLevel::avx512, "avx512"}}) {
+        if(detected < level) {
+            std::cout << "kernels: " << name << " not supported, skipped\n";
+            continue;
+        }
+        compare<int>(level, std::string{name} + " int");
+        compare<long long>(level, std::string{name} + " long long");
+    }
+    return tests::report("kernels");
+}
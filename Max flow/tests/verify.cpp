@@ -0,0 +1,36 @@
+#include "../data structures/graph.h"
+#include "../algorithms/verify.h"
+#include "../algorithms/dinic.h"
+#include "check.h"
+
+/**
+ * The certificate sums flows and cuts in a wider type than the capacities, a sum
+ * wrapping around in T must not certify a wrong value.
+ */
+
+using tests::check;
+
+int main() {
+    // four saturated edges of 2^30 from the source to the sink: a flow of 2^32, 0 in 32 bits
+    {
+        ds::Graph<int> graph{2};
+        for(int k{0}; k < 4; ++k) {
+            graph.add_edge(0, 1, 1 << 30);
+        }
+        for(auto* edge : graph.m_adj_list[0]) {
+            edge->reverse->capacity += edge->capacity;
+            edge->capacity = 0;
+        }
+        auto certificate{algorithms::verify_max_flow(graph, 0)};
+        check(!certificate.valid, "wrapped flow into the sink not certified");
+    }
+    // cuts of 2^33 in front of a maximum flow of 1
+    {
+        ds::Graph<int> graph{tests::funnel(8, 1 << 30, 1)};
+        int flow{algorithms::dinic(graph)};
+        auto certificate{algorithms::verify_max_flow(graph, flow)};
+        check(flow == 1 && certificate.valid, "maximum flow behind large cuts certified");
+        check(!algorithms::verify_max_flow(graph, 2).valid, "wrong value not certified");
+    }
+    return tests::report("verify");
+}
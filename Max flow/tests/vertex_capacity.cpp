@@ -0,0 +1,66 @@
+#include "../data structures/graph.h"
+#include "../algorithms/dinic.h"
+#include "check.h"
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Changing the capacity of a split vertex has to find its inner edge even
+ * after the adjacency lists were shuffled or the vertices relabeled.
+ */
+
+using tests::check;
+
+int main() {
+    {
+        ds::Graph<int> graph{tests::diamond(50)};
+        check(algorithms::dinic(graph) == 50, "vertex capacity limits the flow");
+        graph.restore();
+        graph.set_vertex_capacity(1, 20);
+        check(algorithms::dinic(graph) == 20, "changed vertex capacity");
+    }
+    // every seed that moves the inner edge away from the front of the second half's list
+    for(unsigned seed{0}; seed < 16; ++seed) {
+        ds::Graph<int> graph{tests::diamond(50)};
+        graph.shuffle_edges(seed);
+        graph.set_vertex_capacity(1, 7);
+        check(algorithms::dinic(graph) == 7, "vertex capacity after shuffle_edges");
+    }
+    {
+        ds::Graph<int> graph{tests::diamond(50)};
+        std::vector<int> order(graph.m_n);
+        std::iota(order.rbegin(), order.rend(), 0);
+        graph.relabel(order);
+        graph.set_vertex_capacity(graph.current_id(1), 3);
+        check(algorithms::dinic(graph) == 3, "vertex capacity after relabel");
+        graph.restore();
+        graph.shuffle_edges(1);
+        graph.set_vertex_capacity(graph.current_id(1), 60);
+        check(algorithms::dinic(graph) == 60, "vertex capacity after relabel and shuffle_edges");
+    }
+    // a sink can't be capped (its flow would never cross the inner edge)
+    {
+        ds::Graph<int> graph{tests::diamond(50)};
+        bool rejected{false};
+        try {
+            graph.set_vertex_capacity(graph.m_t, 5);
+        } catch(const std::invalid_argument&) {
+            rejected = true;
+        }
+        check(rejected, "vertex capacity on the sink rejected");
+        check(algorithms::dinic(graph) == 50, "sink unchanged after the rejected capacity");
+    }
+    {
+        ds::Graph<int> graph{tests::diamond(50)};
+        bool rejected{false};
+        try {
+            graph.set_sinks({10, 1});
+        } catch(const std::invalid_argument&) {
+            rejected = true;
+        }
+        check(rejected, "vertex with a capacity rejected as a sink");
+    }
+    return tests::report("vertex_capacity");
+}